@@ -20,6 +20,8 @@
 
 #include "HSMIDI.h"
 
+#if ENABLE_APP_Backup
+
 class Backup: public SystemExclusiveHandler {
 public:
     void Init() {
@@ -157,3 +159,5 @@ void Backup_handleButtonEvent(const UI::Event &event) {
         if (event.control == OC::CONTROL_BUTTON_R) Backup_instance.OnSendSysEx();
     }
 }
+
+#endif // ENABLE_APP_Backup
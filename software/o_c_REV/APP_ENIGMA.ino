@@ -27,6 +27,8 @@
 #include "enigma/EnigmaOutput.h"
 #include "enigma/EnigmaTrack.h"
 
+#if ENABLE_APP_EnigmaTMWS
+
 // Modes
 #define ENIGMA_MODE_LIBRARY 0  // Create, edit, save, favorite, sysex dump Turing Machines
 #define ENIGMA_MODE_ASSIGN 1   // Assign CV and MIDI output
@@ -106,10 +108,31 @@ public:
     }
 
     void View() {
-        DrawHeader();
         DrawInterface();
     }
 
+    uint32_t ChromeKey() {
+        return (mode + 1) | (help_countdown ? 0x100 : 0);
+    }
+
+    void DrawChrome() {
+        DrawHeader();
+        if (mode == ENIGMA_MODE_LIBRARY) DrawSelectorBox("Register");
+        if (mode == ENIGMA_MODE_ASSIGN) {
+            DrawSelectorBox("Output");
+            if (!help_countdown) gfxLine(48, 23, 127, 23);
+        }
+        if (mode == ENIGMA_MODE_SONG) DrawSelectorBox("Track");
+        if (mode == ENIGMA_MODE_PLAY && !help_countdown) {
+            // Headers
+            // Track, Step/Repeat, Register, Divide, Loop
+            gfxPrint(0, 15, "Tk Step  Reg");
+            gfxLine(0, 23, 127, 23);
+            gfxIcon(80, 14, CLOCK_ICON);
+            gfxIcon(106, 14, LOOP_ICON);
+        }
+    }
+
     // Public access to save method
     void OnSaveSettings() {SaveToEEPROMStage();}
 
@@ -366,7 +389,7 @@ private:
             gfxPrint(3, y, name);
             if (HS::user_turing_machines[ix].favorite) gfxIcon(36, y, FAVORITE_ICON);
         }
-        DrawSelectorBox("Register");
+        gfxInvert(1, 24, 46, 9); // Selected object
 
         if (help_countdown) DrawLibraryHelp();
         else {
@@ -412,7 +435,7 @@ private:
             gfxPrint(": Tk");
             gfxPrint(output[ix].track() + 1);
         }
-        DrawSelectorBox("Output");
+        gfxInvert(1, 24, 46, 9); // Selected object
 
         if (help_countdown) DrawAssignHelp();
         else {
@@ -442,7 +465,6 @@ private:
             // Audition
             gfxIcon(56, 15, AUDITION_ICON);
             gfxPrint(68, 15, assign_audition ? "Song" : "Library");
-            gfxLine(48, 23, 127, 23);
         }
     }
 
@@ -461,7 +483,7 @@ private:
             gfxPrint(3, y, "Track");
             gfxPrint(39, y, t + 1);
         }
-        DrawSelectorBox("Track");
+        gfxInvert(1, 24, 46, 9); // Selected object
 
 
         if (help_countdown) DrawSongHelp();
@@ -544,13 +566,6 @@ private:
 
         if (help_countdown) DrawPlayHelp();
         else {
-            // Headers
-            // Track, Step/Repeat, Register, Divide, Loop
-            gfxPrint(0, 15, "Tk Step  Reg");
-            gfxLine(0, 23, 127, 23);
-            gfxIcon(80, 14, CLOCK_ICON);
-            gfxIcon(106, 14, LOOP_ICON);
-
             for (int t = 0; t < 4; t++)
             {
                 uint16_t ssi = playback_step_index[t]; // playback_step_index is the index of the song_step
@@ -624,15 +639,14 @@ private:
 
 
     /*
-     *  Used by all Modes to allow selection of Primary Objects. This should go after the
-     *  lines are drawn, because the first name on the list, as the selected object, is
-     *  reversed
+     *  Used by all Modes to allow selection of Primary Objects. This is part of the chrome;
+     *  the interface draws the names and then reverses the first name on the list, as the
+     *  selected object
      */
     void DrawSelectorBox(const char* object) {
         gfxPrint(0, 15, object);
         gfxFrame(0, 23, 48, 40); // Selector window
         for (byte line = 0; line < 3; line++) gfxLine(0, 32 + (10 * line),  47, 32 + (10 * line));
-        gfxInvert(1, 24, 46, 9);
     }
 
     // When a new TM is selected, load it here
@@ -1234,4 +1248,4 @@ void EnigmaTMWS_handleEncoderEvent(const UI::Event &event) {
     if (event.control == OC::CONTROL_ENCODER_R) EnigmaTMWS_instance.OnRightEncoderMove(event.value);
 }
 
-
+#endif // ENABLE_APP_EnigmaTMWS
@@ -22,7 +22,6 @@
 #include "OC_digital_inputs.h"
 #include "OC_visualfx.h"
 #include "OC_patterns.h"
-#include "src/drivers/FreqMeasure/OC_FreqMeasure.h"
 namespace menu = OC::menu;
 
 #include "hemisphere_config.h"
@@ -31,8 +30,10 @@ namespace menu = OC::menu;
 #include "HSMIDI.h"
 #include "HSClockManager.h"
 
+#if ENABLE_APP_HEMISPHERE
+
 #define DECLARE_APPLET(id, categories, class_name) \
-{ id, categories, class_name ## _Start, class_name ## _Controller, class_name ## _View, \
+{ id, categories, class_name ## _Start, class_name ## _Controller, class_name ## _View, class_name ## _ViewHash, \
   class_name ## _OnButtonPress, class_name ## _OnEncoderMove, class_name ## _ToggleHelpScreen, \
   class_name ## _OnDataRequest, class_name ## _OnDataReceive \
 }
@@ -45,6 +46,7 @@ typedef struct Applet {
   void (*Start)(bool); // Initialize when selected
   void (*Controller)(bool, bool);  // Interrupt Service Routine
   void (*View)(bool);  // Draw main view
+  uint32_t (*ViewHash)(bool); // Hash of the view state, to skip unchanged views
   void (*OnButtonPress)(bool); // Encoder button has been pressed
   void (*OnEncoderMove)(bool, int); // Encoder has been rotated
   void (*ToggleHelpScreen)(bool); // Help Screen has been requested
@@ -70,15 +72,26 @@ enum HEMISPHERE_SETTINGS {
 class HemisphereManager : public SystemExclusiveHandler,
     public settings::SettingsBase<HemisphereManager, HEMISPHERE_SETTING_LAST> {
 public:
+    // Header icons, only pre-shifted for y = 1 where they're drawn
+    typedef weegfx::PreshiftedBitmap8<8, 1 << 1> HemisphereIcon;
+
     void Init() {
         select_mode = -1; // Not selecting
         midi_in_hemisphere = -1; // No MIDI In
         Applet applets[] = HEMISPHERE_APPLETS;
+        static_assert(sizeof(applets) / sizeof(Applet) == HEMISPHERE_AVAILABLE_APPLETS,
+                      "OC_build_profile.h is out of date, re-run resources/build_profile.py");
         memcpy(&available_applets, &applets, sizeof(applets));
         ClockSetup = DECLARE_APPLET(9999, 0x01, ClockSetup);
 
         help_hemisphere = -1;
         clock_setup = 0;
+        view_frame_valid = false;
+        active = false;
+
+        metro_l_icon.Init(METRO_L_ICON);
+        metro_r_icon.Init(METRO_R_ICON);
+        clock_icon.Init(CLOCK_ICON);
 
         SetApplet(0, get_applet_index_by_id(8)); // ADSR
         SetApplet(1, get_applet_index_by_id(26)); // Scale Duet
@@ -100,6 +113,35 @@ public:
         if (available_applets[index].id & 0x80) midi_in_hemisphere = hemisphere;
         available_applets[index].Start(hemisphere);
         apply_value(hemisphere, available_applets[index].id);
+        UpdateScanSchedule();
+    }
+
+    // Called on APP_EVENT_RESUME/SUSPEND. Applets are also started when the app
+    // isn't current (Init, restore), so the ADC scan schedule is only changed
+    // while it is.
+    void SetActive(bool is_active) {
+        active = is_active;
+        if (active) UpdateScanSchedule();
+        else OC::ADC::set_scan_weights(nullptr);
+    }
+
+    // Give more ADC scan slots to the inputs of applets that need them
+    void UpdateScanSchedule() {
+        if (!active) return;
+        static const struct { int id; uint8_t inputs; } fast_inputs[] = HEMISPHERE_FAST_INPUTS;
+        uint8_t weights[ADC_CHANNEL_LAST];
+        for (int h = 0; h < 2; h++)
+        {
+            uint8_t inputs = 0;
+            for (const auto &fast : fast_inputs) {
+                if (fast.id == available_applets[my_applet[h]].id) inputs = fast.inputs;
+            }
+            for (int ch = 0; ch < 2; ch++)
+            {
+                weights[h * 2 + ch] = (inputs & (1 << ch)) ? HEMISPHERE_FAST_INPUT_WEIGHT : 1;
+            }
+        }
+        OC::ADC::set_scan_weights(weights);
     }
 
     void ChangeApplet(int dir) {
@@ -134,32 +176,49 @@ public:
     }
 
     void DrawViews() {
+        // The full-screen views are always redrawn
         if (clock_setup) {
             ClockSetup.View(LEFT_HEMISPHERE);
+            view_frame_valid = false;
         } else if (help_hemisphere > -1) {
             int index = my_applet[help_hemisphere];
             available_applets[index].View(help_hemisphere);
+            view_frame_valid = false;
         } else {
+            // If the previous frame was also drawn here, a hemisphere whose view hasn't
+            // changed is copied from it instead of being redrawn. With a single frame
+            // buffer, the previous frame has already been cleared for this one.
+            // Applet headers are drawn by the applets' View(), so they aren't cached
+            // in a chrome layer; they're only redrawn with a changed view anyway.
+            size_t frame = display::frame_buffer.frames_written();
+            bool previous_valid = display::kNumFrames > 1 && view_frame_valid && frame == view_frame + 1;
             for (int h = 0; h < 2; h++)
             {
                 int index = my_applet[h];
-                available_applets[index].View(h);
-                if (h == 0) {
-                    if (clock_m->IsRunning() || clock_m->IsPaused()) {
-                        // Metronome icon
-                        graphics.drawBitmap8(56, 1, 8, clock_m->Cycle() ? METRO_L_ICON : METRO_R_ICON);
-                    } else if (clock_m->IsForwarded()) {
-                        // CV Forwarding Icon
-                        graphics.drawBitmap8(56, 1, 8, CLOCK_ICON);
-                    }
+                uint32_t hash = HemisphereApplet::ViewHashOf(available_applets[index].ViewHash(h),
+                                                             index, select_mode == h,
+                                                             h ? 0 : reinterpret_cast<uintptr_t>(ClockIcon()));
+                if (previous_valid && hash == view_hash[h]) {
+                    graphics.copyColumns(display::frame_buffer.last_written_frame(), h * 64, 64);
+                } else {
+                    available_applets[index].View(h);
+                    if (h == 0 && ClockIcon()) graphics.drawBitmap8(56, 1, *ClockIcon());
+                    if (select_mode == h) graphics.drawFrame(h * 64, 0, 64, 64);
                 }
+                view_hash[h] = hash;
             }
-
-            if (select_mode == LEFT_HEMISPHERE) graphics.drawFrame(0, 0, 64, 64);
-            if (select_mode == RIGHT_HEMISPHERE) graphics.drawFrame(64, 0, 64, 64);
+            view_frame = frame;
+            view_frame_valid = true;
         }
     }
 
+    // Metronome or CV forwarding icon in the left hemisphere
+    const HemisphereIcon *ClockIcon() {
+        if (clock_m->IsRunning() || clock_m->IsPaused()) return clock_m->Cycle() ? &metro_l_icon : &metro_r_icon;
+        if (clock_m->IsForwarded()) return &clock_icon;
+        return nullptr;
+    }
+
     void DelegateEncoderPush(const UI::Event &event) {
         int h = (event.control == OC::CONTROL_BUTTON_L) ? LEFT_HEMISPHERE : RIGHT_HEMISPHERE;
         if (clock_setup) {
@@ -288,6 +347,11 @@ private:
     int my_applet[2]; // Indexes to available_applets
     int select_mode;
     bool clock_setup;
+    uint32_t view_hash[2]; // Hash of each hemisphere's view state in the previous frame
+    size_t view_frame; // Number of the last frame drawn by DrawViews()
+    HemisphereIcon metro_l_icon, metro_r_icon, clock_icon;
+    bool view_frame_valid; // Both hemispheres were drawn in view_frame
+    bool active; // Hemisphere is the current app
     int help_hemisphere; // Which of the hemispheres (if any) is in help mode, or -1 if none
     int midi_in_hemisphere; // Which of the hemispheres (if any) is using MIDI In
     uint32_t click_tick; // Measure time between clicks for double-click
@@ -370,6 +434,12 @@ void FASTRUN HEMISPHERE_isr() {
 void HEMISPHERE_handleAppEvent(OC::AppEvent event) {
     if (event == OC::APP_EVENT_SUSPEND) {
         manager.OnSendSysEx();
+        manager.SetActive(false);
+        for (int ch = DAC_CHANNEL_A; ch < DAC_CHANNEL_LAST; ++ch)
+            OC::DAC::cancel_ramp((DAC_CHANNEL)ch);
+    }
+    if (event == OC::APP_EVENT_RESUME) {
+        manager.SetActive(true);
     }
 }
 
@@ -400,3 +470,5 @@ void HEMISPHERE_handleButtonEvent(const UI::Event &event) {
 void HEMISPHERE_handleEncoderEvent(const UI::Event &event) {
     manager.DelegateEncoderMovement(event);
 }
+
+#endif // ENABLE_APP_HEMISPHERE
@@ -25,6 +25,8 @@
 #include "HSApplication.h"
 #include "HSMIDI.h"
 
+#if ENABLE_APP_MIDI
+
 #define MIDI_INDICATOR_COUNTDOWN 2000
 #define MIDI_PARAMETER_COUNT 40
 #define MIDI_CURRENT_SETUP (MIDI_PARAMETER_COUNT * 4)
@@ -232,6 +234,21 @@ public:
         else DrawLogScreen();
     }
 
+    uint32_t ChromeKey() {
+        if (copy_mode) return 1;
+        if (display) return 2;
+        return 3 | (screen << 2) | (get_setup_number() << 5);
+    }
+
+    void DrawChrome() {
+        if (copy_mode) {
+            gfxHeader("Copy");
+            graphics.setPrintPos(0, 55);
+            graphics.print("[CANCEL]");
+        } else if (display == 0) DrawSetupHeader();
+        else gfxHeader("IO Ch Type  Values");
+    }
+
     void SelectSetup(int setup_number, int new_screen = -1) {
         // Stay the same if not provided
         if (new_screen == -1) new_screen = screen;
@@ -405,7 +422,7 @@ private:
     int legato_on[4]; // The note handler may currently respond to legato note changes
     uint16_t indicator_out[4]; // A MIDI indicator will display next to MIDI Out assignment
 
-    void DrawSetupScreens() {
+    void DrawSetupHeader() {
         // Create the header, showing the current Setup and Screen name
         gfxHeader("");
         if (screen == 0) graphics.print("MIDI Assign");
@@ -415,7 +432,9 @@ private:
         if (screen == 4) graphics.print("Range High");
         gfxPrint(128 - 42, 1, "Setup ");
         gfxPrint(get_setup_number() + 1);
+    }
 
+    void DrawSetupScreens() {
         // Iterate through the current range of settings
         menu::SettingsList<menu::kScreenLines, 0, menu::kDefaultValueX - 1> settings_list(cursor);
         menu::SettingsListItem list_item;
@@ -477,7 +496,6 @@ private:
     }
 
     void DrawLogScreen() {
-        gfxHeader("IO Ch Type  Values");
         if (log_index) {
             for (int l = 0; l < 6; l++)
             {
@@ -498,8 +516,6 @@ private:
     }
 
     void DrawCopyScreen() {
-        gfxHeader("Copy");
-
         graphics.setPrintPos(8, 28);
         graphics.print("Setup ");
         graphics.print(copy_setup_source + 1);
@@ -512,9 +528,6 @@ private:
             graphics.print(copy_setup_target + 1);
         }
 
-        graphics.setPrintPos(0, 55);
-        graphics.print("[CANCEL]");
-
         graphics.setPrintPos(90, 55);
         graphics.print(copy_setup_source == copy_setup_target ? "[DUMP]" : "[COPY]");
     }
@@ -906,4 +919,4 @@ void MIDI_handleEncoderEvent(const UI::Event &event) {
     }
 }
 
-
+#endif // ENABLE_APP_MIDI
@@ -22,6 +22,8 @@
 #include "HSMIDI.h"
 #include "neuralnet/LogicGate.h"
 
+#if ENABLE_APP_NeuralNetwork
+
 // 9 sets of 24 bytes allocated for storage
 #define NN_SETTING_LAST 216
 
@@ -649,3 +651,5 @@ void NeuralNetwork_handleEncoderEvent(const UI::Event &event) {
     // Right encoder turned
     if (event.control == OC::CONTROL_ENCODER_R) NeuralNetwork_instance.OnRightEncoderMove(event.value);
 }
+
+#endif // ENABLE_APP_NeuralNetwork
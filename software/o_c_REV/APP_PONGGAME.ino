@@ -24,6 +24,8 @@
 #include "OC_ADC.h"
 #include "OC_digital_inputs.h"
 
+#if ENABLE_APP_PONGGAME
+
 /* Define the screen boundaries. There's a frame around the screen, so these numbers need to
  * take that into account.
  */
@@ -367,3 +369,5 @@ void PONGGAME_handleEncoderEvent(const UI::Event &event) {
 	if (event.value > 0) pong_instance.MovePaddleDown();
 	pong_instance.ResetPaddle();
 }
+
+#endif // ENABLE_APP_PONGGAME
@@ -25,6 +25,8 @@
 #include "HSMIDI.h"
 #include "SegmentDisplay.h"
 
+#if ENABLE_APP_SCALEEDITOR
+
 class ScaleEditor : public HSApplication, public SystemExclusiveHandler {
 public:
 	void Start() {
@@ -398,3 +400,5 @@ void SCALEEDITOR_handleEncoderEvent(const UI::Event &event) {
     // Right encoder turned
     if (event.control == OC::CONTROL_ENCODER_R) scale_editor_instance.OnRightEncoderMove(event.value);
 }
+
+#endif // ENABLE_APP_SCALEEDITOR
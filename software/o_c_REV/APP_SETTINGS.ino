@@ -20,6 +20,8 @@
 
 #include "HSApplication.h"
 
+#if ENABLE_APP_Settings
+
 // Bitmap representation of QR code for access to http://www.beigemaze.com/hs, which
 // redirects to Hemisphere Suite documentation.
 //
@@ -70,6 +72,19 @@ public:
     }
 
     void View() {
+        // CV input filter profile for each channel
+        for (int ch = 0; ch < ADC_CHANNEL_LAST; ch++) {
+            int x = 10 + ch * 29;
+            gfxPrint(x, 45, OC::Strings::adc_filter_profiles[OC::ADC::filter_profile((ADC_CHANNEL)ch)]);
+            if (ch == filter_cursor) gfxCursor(x, 53, 24);
+        }
+
+        //DrawQRAt(103, 15);
+    }
+
+    uint32_t ChromeKey() {return 1;}
+
+    void DrawChrome() {
         gfxHeader("Setup / About");
         gfxPrint(0, 15, "Hemisphere Suite");
         gfxPrint(0, 25, OC_VERSION);
@@ -79,8 +94,6 @@ public:
 #ifdef BUCHLA_4U
         gfxPrint(60, 25, "Buchla");
 #endif
-
-        //DrawQRAt(103, 15);
     }
 
     /////////////////////////////////////////////////////////////////
@@ -107,12 +120,18 @@ public:
     }
 
     void OnLeftEncoderMove(int direction) {
+        filter_cursor = constrain(filter_cursor + direction, 0, ADC_CHANNEL_LAST - 1);
     }
 
     void OnRightEncoderMove(int direction) {
+        ADC_CHANNEL channel = (ADC_CHANNEL)filter_cursor;
+        int profile = constrain(OC::ADC::filter_profile(channel) + direction, 0, ADC_FILTER_PROFILE_LAST - 1);
+        OC::ADC::set_filter_profile(channel, (ADC_FILTER_PROFILE)profile);
     }
 
 private:
+    int filter_cursor = 0;
+
 /*
     void DrawQRAt(byte x, byte y) {
         for (byte c = 0; c < 25; c++) // Column
@@ -185,3 +204,5 @@ void Settings_handleEncoderEvent(const UI::Event &event) {
     // Right encoder turned
     if (event.control == OC::CONTROL_ENCODER_R) Settings_instance.OnRightEncoderMove(event.value);
 }
+
+#endif // ENABLE_APP_Settings
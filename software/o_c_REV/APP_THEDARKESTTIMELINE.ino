@@ -30,6 +30,8 @@
 #include "HSApplication.h"
 #include "HSMIDI.h"
 
+#if ENABLE_APP_TheDarkestTimeline
+
 #define DT_CV_TIMELINE 0
 #define DT_PROBABILITY_TIMELINE 1
 #define DT_SETUP_SCREEN_TIMEOUT 166667
@@ -589,3 +591,5 @@ void TheDarkestTimeline_handleEncoderEvent(const UI::Event &event) {
     // Right encoder turned
     if (event.control == OC::CONTROL_ENCODER_R) TheDarkestTimeline_instance.OnRightEncoderMove(event.value);
 }
+
+#endif // ENABLE_APP_TheDarkestTimeline
@@ -23,6 +23,8 @@
 #include "vector_osc/HSVectorOscillator.h"
 #include "vector_osc/WaveformManager.h"
 
+#if ENABLE_APP_WaveformEditor
+
 class WaveformEditor : public HSApplication, public SystemExclusiveHandler {
 public:
     void Start() {
@@ -423,3 +425,5 @@ void WaveformEditor_handleEncoderEvent(const UI::Event &event) {
     // Right encoder turned
     if (event.control == OC::CONTROL_ENCODER_R) WaveformEditor_instance.OnRightEncoderMove(event.value);
 }
+
+#endif // ENABLE_APP_WaveformEditor
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_ADEG
+
 #define HEM_ADEG_MAX_VALUE 255
 #define HEM_ADEG_MAX_TICKS 33333
 
@@ -180,8 +182,11 @@ ADEG ADEG_instance[2];
 void ADEG_Start(bool hemisphere) {ADEG_instance[hemisphere].BaseStart(hemisphere);}
 void ADEG_Controller(bool hemisphere, bool forwarding) {ADEG_instance[hemisphere].BaseController(forwarding);}
 void ADEG_View(bool hemisphere) {ADEG_instance[hemisphere].BaseView();}
+uint32_t ADEG_ViewHash(bool hemisphere) {return ADEG_instance[hemisphere].ViewHash();}
 void ADEG_OnButtonPress(bool hemisphere) {ADEG_instance[hemisphere].OnButtonPress();}
 void ADEG_OnEncoderMove(bool hemisphere, int direction) {ADEG_instance[hemisphere].OnEncoderMove(direction);}
 void ADEG_ToggleHelpScreen(bool hemisphere) {ADEG_instance[hemisphere].HelpScreen();}
 uint32_t ADEG_OnDataRequest(bool hemisphere) {return ADEG_instance[hemisphere].OnDataRequest();}
 void ADEG_OnDataReceive(bool hemisphere, uint32_t data) {ADEG_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_ADEG
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_ADSREG
+
 #define HEM_EG_ATTACK 0
 #define HEM_EG_DECAY 1
 #define HEM_EG_SUSTAIN 2
@@ -284,6 +286,10 @@ void ADSREG_View(bool hemisphere) {
     ADSREG_instance[hemisphere].BaseView();
 }
 
+uint32_t ADSREG_ViewHash(bool hemisphere) {
+    return ADSREG_instance[hemisphere].ViewHash();
+}
+
 void ADSREG_OnButtonPress(bool hemisphere) {
     ADSREG_instance[hemisphere].OnButtonPress();
 }
@@ -303,3 +309,5 @@ uint32_t ADSREG_OnDataRequest(bool hemisphere) {
 void ADSREG_OnDataReceive(bool hemisphere, uint32_t data) {
     ADSREG_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_ADSREG
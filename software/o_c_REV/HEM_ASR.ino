@@ -22,6 +22,8 @@
 
 #include "HSRingBufferManager.h" // Singleton Ring Buffer manager
 
+#if ENABLE_APPLET_ASR
+
 class ASR : public HemisphereApplet {
 public:
 
@@ -152,8 +154,11 @@ ASR ASR_instance[2];
 void ASR_Start(bool hemisphere) {ASR_instance[hemisphere].BaseStart(hemisphere);}
 void ASR_Controller(bool hemisphere, bool forwarding) {ASR_instance[hemisphere].BaseController(forwarding);}
 void ASR_View(bool hemisphere) {ASR_instance[hemisphere].BaseView();}
+uint32_t ASR_ViewHash(bool hemisphere) {return ASR_instance[hemisphere].ViewHash();}
 void ASR_OnButtonPress(bool hemisphere) {ASR_instance[hemisphere].OnButtonPress();}
 void ASR_OnEncoderMove(bool hemisphere, int direction) {ASR_instance[hemisphere].OnEncoderMove(direction);}
 void ASR_ToggleHelpScreen(bool hemisphere) {ASR_instance[hemisphere].HelpScreen();}
 uint32_t ASR_OnDataRequest(bool hemisphere) {return ASR_instance[hemisphere].OnDataRequest();}
 void ASR_OnDataReceive(bool hemisphere, uint32_t data) {ASR_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_ASR
@@ -21,6 +21,9 @@
 // SOFTWARE.
 
 #include "bjorklund.h"
+
+#if ENABLE_APPLET_AnnularFusion
+
 #define AF_DISPLAY_TIMEOUT 330000
 
 struct AFStepCoord {
@@ -264,6 +267,10 @@ void AnnularFusion_View(bool hemisphere) {
     AnnularFusion_instance[hemisphere].BaseView();
 }
 
+uint32_t AnnularFusion_ViewHash(bool hemisphere) {
+    return AnnularFusion_instance[hemisphere].ViewHash();
+}
+
 void AnnularFusion_OnButtonPress(bool hemisphere) {
     AnnularFusion_instance[hemisphere].OnButtonPress();
 }
@@ -283,3 +290,5 @@ uint32_t AnnularFusion_OnDataRequest(bool hemisphere) {
 void AnnularFusion_OnDataReceive(bool hemisphere, uint32_t data) {
     AnnularFusion_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_AnnularFusion
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_AttenuateOffset
+
 #define ATTENOFF_INCREMENTS 128
 
 class AttenuateOffset : public HemisphereApplet {
@@ -29,15 +31,15 @@ public:
 
     void Start() {
         ForEachChannel(ch) level[ch] = 63;
+        UpdateLevels();
     }
 
     void Controller() {
-        ForEachChannel(ch)
-        {
-            int signal = Proportion(level[ch], 63, In(ch)) + (offset[ch] * ATTENOFF_INCREMENTS);
-            signal = constrain(signal, -HEMISPHERE_3V_CV, HEMISPHERE_MAX_CV);
-            Out(ch, signal);
-        }
+        // Both channels at once: signal = In * level + offset, constrained
+        simd2::int16x2 signal = simd2::mul_shift<14>(gain, simd2::pack(In(0), In(1)));
+        signal = simd2::qadd(signal, offset_cv);
+        signal = simd2::clamp(signal, simd2::splat(-HEMISPHERE_3V_CV), simd2::splat(HEMISPHERE_MAX_CV));
+        ForEachChannel(ch) Out(ch, simd2::lane(signal, ch));
     }
 
     void View() {
@@ -61,6 +63,7 @@ public:
             // Change level percentage
             level[ch] = constrain(level[ch] + direction, 0, 63);
         }
+        UpdateLevels();
 
     }
         
@@ -78,6 +81,7 @@ public:
         offset[1] = Unpack(data, PackLocation {10,9}) - 256;
         level[0] = Unpack(data, PackLocation {19,6});
         level[1] = Unpack(data, PackLocation {25,6});
+        UpdateLevels();
     }
 
 protected:
@@ -94,7 +98,14 @@ private:
     int cursor;
     int level[2];
     int offset[2];
-    
+    simd2::int16x2 gain; // simfloat level for each channel
+    simd2::int16x2 offset_cv; // Offset in CV units for each channel
+
+    void UpdateLevels() {
+        gain = simd2::pack(int2simfloat(level[0]) / 63, int2simfloat(level[1]) / 63);
+        offset_cv = simd2::pack(offset[0] * ATTENOFF_INCREMENTS, offset[1] * ATTENOFF_INCREMENTS);
+    }
+
     void DrawInterface() {
         ForEachChannel(ch)
         {
@@ -126,8 +137,11 @@ AttenuateOffset AttenuateOffset_instance[2];
 void AttenuateOffset_Start(bool hemisphere) {AttenuateOffset_instance[hemisphere].BaseStart(hemisphere);}
 void AttenuateOffset_Controller(bool hemisphere, bool forwarding) {AttenuateOffset_instance[hemisphere].BaseController(forwarding);}
 void AttenuateOffset_View(bool hemisphere) {AttenuateOffset_instance[hemisphere].BaseView();}
+uint32_t AttenuateOffset_ViewHash(bool hemisphere) {return AttenuateOffset_instance[hemisphere].ViewHash();}
 void AttenuateOffset_OnButtonPress(bool hemisphere) {AttenuateOffset_instance[hemisphere].OnButtonPress();}
 void AttenuateOffset_OnEncoderMove(bool hemisphere, int direction) {AttenuateOffset_instance[hemisphere].OnEncoderMove(direction);}
 void AttenuateOffset_ToggleHelpScreen(bool hemisphere) {AttenuateOffset_instance[hemisphere].HelpScreen();}
 uint32_t AttenuateOffset_OnDataRequest(bool hemisphere) {return AttenuateOffset_instance[hemisphere].OnDataRequest();}
 void AttenuateOffset_OnDataReceive(bool hemisphere, uint32_t data) {AttenuateOffset_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_AttenuateOffset
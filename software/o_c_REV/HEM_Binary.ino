@@ -20,6 +20,8 @@
 
 #include "SegmentDisplay.h"
 
+#if ENABLE_APPLET_Binary
+
 class Binary : public HemisphereApplet {
 public:
 
@@ -120,6 +122,10 @@ void Binary_View(bool hemisphere) {
     Binary_instance[hemisphere].BaseView();
 }
 
+uint32_t Binary_ViewHash(bool hemisphere) {
+    return Binary_instance[hemisphere].ViewHash();
+}
+
 void Binary_OnButtonPress(bool hemisphere) {
     Binary_instance[hemisphere].OnButtonPress();
 }
@@ -139,3 +145,5 @@ uint32_t Binary_OnDataRequest(bool hemisphere) {
 void Binary_OnDataReceive(bool hemisphere, uint32_t data) {
     Binary_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Binary
@@ -21,6 +21,8 @@
 #include "vector_osc/HSVectorOscillator.h"
 #include "vector_osc/WaveformManager.h"
 
+#if ENABLE_APPLET_BootsNCat
+
 #define BNC_MAX_PARAM 63
 
 class BootsNCat : public HemisphereApplet {
@@ -216,8 +218,11 @@ BootsNCat BootsNCat_instance[2];
 void BootsNCat_Start(bool hemisphere) {BootsNCat_instance[hemisphere].BaseStart(hemisphere);}
 void BootsNCat_Controller(bool hemisphere, bool forwarding) {BootsNCat_instance[hemisphere].BaseController(forwarding);}
 void BootsNCat_View(bool hemisphere) {BootsNCat_instance[hemisphere].BaseView();}
+uint32_t BootsNCat_ViewHash(bool hemisphere) {return BootsNCat_instance[hemisphere].ViewHash();}
 void BootsNCat_OnButtonPress(bool hemisphere) {BootsNCat_instance[hemisphere].OnButtonPress();}
 void BootsNCat_OnEncoderMove(bool hemisphere, int direction) {BootsNCat_instance[hemisphere].OnEncoderMove(direction);}
 void BootsNCat_ToggleHelpScreen(bool hemisphere) {BootsNCat_instance[hemisphere].HelpScreen();}
 uint32_t BootsNCat_OnDataRequest(bool hemisphere) {return BootsNCat_instance[hemisphere].OnDataRequest();}
 void BootsNCat_OnDataReceive(bool hemisphere, uint32_t data) {BootsNCat_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_BootsNCat
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Brancher
+
 class Brancher : public HemisphereApplet {
 public:
 
@@ -52,6 +54,10 @@ public:
         DrawInterface();
     }
 
+    uint32_t ViewHash() {
+        return ViewHashOf(p, choice, CursorBlink());
+    }
+
     void OnButtonPress() {
     		choice = 1 - choice;
     }
@@ -119,6 +125,10 @@ void Brancher_View(bool hemisphere) {
     Brancher_instance[hemisphere].BaseView();
 }
 
+uint32_t Brancher_ViewHash(bool hemisphere) {
+    return Brancher_instance[hemisphere].ViewHash();
+}
+
 void Brancher_OnButtonPress(bool hemisphere) {
     Brancher_instance[hemisphere].OnButtonPress();
 }
@@ -138,3 +148,5 @@ uint32_t Brancher_OnDataRequest(bool hemisphere) {
 void Brancher_OnDataReceive(bool hemisphere, uint32_t data) {
     Brancher_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Brancher
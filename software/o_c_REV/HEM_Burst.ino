@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Burst
+
 #define HEM_BURST_NUMBER_MAX 12
 #define HEM_BURST_SPACING_MAX 500
 #define HEM_BURST_SPACING_MIN 8
@@ -53,11 +55,9 @@ public:
         if (Clock(0)) {
             if (clocked) {
                 // Get a tempo, if this is the second tick or later since the last clock
-                spacing = (ticks_since_clock / number) / 17;
-                ticks_since_clock = 0;
+                spacing = (ClockPeriodTicks(0) / number) / 17;
             } else clocked = 1;
         }
-        ticks_since_clock++;
 
         // Get spacing with clock division or multiplication calculated
         int effective_spacing = get_effective_spacing();
@@ -148,7 +148,6 @@ private:
     int bursts_to_go; // Counts down to end of burst set
     bool clocked; // When a clock signal is received at Digital 1, clocked is activated, and the
                   // spacing of a new burst is number/clock length.
-    int ticks_since_clock; // When clocked, this is the time since the last clock.
     int last_number_cv_tick; // The last time the number was changed via CV. This is used to
                              // decide whether the ADC delay should be used when clocks come in.
 
@@ -219,6 +218,10 @@ void Burst_View(bool hemisphere) {
     Burst_instance[hemisphere].BaseView();
 }
 
+uint32_t Burst_ViewHash(bool hemisphere) {
+    return Burst_instance[hemisphere].ViewHash();
+}
+
 void Burst_OnButtonPress(bool hemisphere) {
     Burst_instance[hemisphere].OnButtonPress();
 }
@@ -238,3 +241,5 @@ uint32_t Burst_OnDataRequest(bool hemisphere) {
 void Burst_OnDataReceive(bool hemisphere, uint32_t data) {
     Burst_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Burst
@@ -19,6 +19,9 @@
 // SOFTWARE.
 
 #include "SegmentDisplay.h"
+
+#if ENABLE_APPLET_CVRecV2
+
 #define CVREC_MAX_STEP 384
 
 const char* const CVRecV2_MODES[4] = {
@@ -205,8 +208,11 @@ CVRecV2 CVRecV2_instance[2];
 void CVRecV2_Start(bool hemisphere) {CVRecV2_instance[hemisphere].BaseStart(hemisphere);}
 void CVRecV2_Controller(bool hemisphere, bool forwarding) {CVRecV2_instance[hemisphere].BaseController(forwarding);}
 void CVRecV2_View(bool hemisphere) {CVRecV2_instance[hemisphere].BaseView();}
+uint32_t CVRecV2_ViewHash(bool hemisphere) {return CVRecV2_instance[hemisphere].ViewHash();}
 void CVRecV2_OnButtonPress(bool hemisphere) {CVRecV2_instance[hemisphere].OnButtonPress();}
 void CVRecV2_OnEncoderMove(bool hemisphere, int direction) {CVRecV2_instance[hemisphere].OnEncoderMove(direction);}
 void CVRecV2_ToggleHelpScreen(bool hemisphere) {CVRecV2_instance[hemisphere].HelpScreen();}
 uint32_t CVRecV2_OnDataRequest(bool hemisphere) {return CVRecV2_instance[hemisphere].OnDataRequest();}
 void CVRecV2_OnDataReceive(bool hemisphere, uint32_t data) {CVRecV2_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_CVRecV2
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Calculate
+
 // Arithmetic functions and typedef to function pointer
 #define HEMISPHERE_NUMBER_OF_CALC 7
 int hem_MIN(int v1, int v2) {return (v1 < v2) ? v1 : v2;}
@@ -157,6 +159,10 @@ void Calculate_View(bool hemisphere) {
     Calculate_instance[hemisphere].BaseView();
 }
 
+uint32_t Calculate_ViewHash(bool hemisphere) {
+    return Calculate_instance[hemisphere].ViewHash();
+}
+
 void Calculate_OnButtonPress(bool hemisphere) {
     Calculate_instance[hemisphere].OnButtonPress();
 }
@@ -176,3 +182,5 @@ uint32_t Calculate_OnDataRequest(bool hemisphere) {
 void Calculate_OnDataReceive(bool hemisphere, uint32_t data) {
     Calculate_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Calculate
@@ -22,6 +22,9 @@
 
 #include "hem_arp_chord.h"
 #include "HSMIDI.h"
+
+#if ENABLE_APPLET_Carpeggio
+
 #define HEM_CARPEGGIO_ANIMATION_SPEED 500
 
 class Carpeggio : public HemisphereApplet {
@@ -219,6 +222,10 @@ void Carpeggio_View(bool hemisphere) {
     Carpeggio_instance[hemisphere].BaseView();
 }
 
+uint32_t Carpeggio_ViewHash(bool hemisphere) {
+    return Carpeggio_instance[hemisphere].ViewHash();
+}
+
 void Carpeggio_OnButtonPress(bool hemisphere) {
     Carpeggio_instance[hemisphere].OnButtonPress();
 }
@@ -238,3 +245,5 @@ uint32_t Carpeggio_OnDataRequest(bool hemisphere) {
 void Carpeggio_OnDataReceive(bool hemisphere, uint32_t data) {
     Carpeggio_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Carpeggio
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_ClockDivider
+
 #define HEM_CLOCKDIV_MAX 8
 
 class ClockDivider : public HemisphereApplet {
@@ -33,14 +35,12 @@ public:
             div[ch] = ch + 1;
             count[ch] = 0;
             next_clock[ch] = 0;
+            clock_every[ch] = 0;
         }
-        cycle_time = 0;
         cursor = 0;
     }
 
     void Controller() {
-        int this_tick = OC::CORE::ticks;
-
         // Set division via CV
         ForEachChannel(ch)
         {
@@ -58,20 +58,22 @@ public:
 
         // The input was clocked; set timing info
         if (Clock(0)) {
-        		cycle_time = ClockCycleTicks(0);
             // At the clock input, handle clock division
             ForEachChannel(ch)
             {
-                count[ch]++;
+                count[ch] += ClockCount(0);
                 if (div[ch] > 0) { // Positive value indicates clock division
                     if (count[ch] >= div[ch]) {
-                        count[ch] = 0; // Reset
+                        count[ch] %= div[ch]; // Reset, keeping clocks of a burst
                         ClockOut(ch);
                     }
                 } else {
-                    // Calculate next clock for multiplication on each clock
-                    int clock_every = (cycle_time / -div[ch]);
-                    next_clock[ch] = this_tick + clock_every;
+                    // Calculate next clock for multiplication on each clock. This
+                    // is timed from the input edge with sub-tick precision, so the
+                    // multiplied clocks don't drift against the input.
+                    clock_every[ch] = ClockCyclePrecise(0) / -div[ch];
+                    next_clock[ch] = clock_every[ch] - ClockEdgeAge(0);
+                    count[ch] = 1;
                     ClockOut(ch); // Sync
                 }
             }
@@ -81,11 +83,13 @@ public:
         ForEachChannel(ch)
         {
             if (div[ch] < 0) { // Negative value indicates clock multiplication
-                if (this_tick >= next_clock[ch]) {
-                    int clock_every = (cycle_time / -div[ch]);
-                    next_clock[ch] += clock_every;
+                // The last multiplied clock of a cycle is the next input clock
+                if (next_clock[ch] <= 0 && count[ch] < -div[ch]) {
+                    next_clock[ch] += clock_every[ch];
+                    count[ch]++;
                     ClockOut(ch);
                 }
+                next_clock[ch] -= 1 << OC::DigitalInputs::kEdgeFracBits;
             }
         }
     }
@@ -95,6 +99,10 @@ public:
         DrawSelector();
     }
 
+    uint32_t ViewHash() {
+        return ViewHashOf(div[0], div[1], cursor, CursorBlink());
+    }
+
     void OnButtonPress() {
         cursor = 1 - cursor;
         ResetCursor();
@@ -132,9 +140,9 @@ protected:
 private:
     int div[2]; // Division data for outputs. Positive numbers are divisions, negative numbers are multipliers
     int count[2]; // Number of clocks since last output (for clock divide)
-    int next_clock[2]; // Tick number for the next output (for clock multiply)
+    int next_clock[2]; // Time until the next output (for clock multiply)
+    int clock_every[2]; // Time between outputs (for clock multiply)
     int cursor; // Which output is currently being edited
-    int cycle_time; // Cycle time between the last two clock inputs
 
     void DrawSelector() {
         ForEachChannel(ch)
@@ -179,6 +187,10 @@ void ClockDivider_View(bool hemisphere) {
     ClockDivider_instance[hemisphere].BaseView();
 }
 
+uint32_t ClockDivider_ViewHash(bool hemisphere) {
+    return ClockDivider_instance[hemisphere].ViewHash();
+}
+
 void ClockDivider_OnButtonPress(bool hemisphere) {
     ClockDivider_instance[hemisphere].OnButtonPress();
 }
@@ -198,3 +210,5 @@ uint32_t ClockDivider_OnDataRequest(bool hemisphere) {
 void ClockDivider_OnDataReceive(bool hemisphere, uint32_t data) {
     ClockDivider_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_ClockDivider
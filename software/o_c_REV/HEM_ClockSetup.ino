@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APP_HEMISPHERE
+
 class ClockSetup : public HemisphereApplet {
 public:
 
@@ -130,8 +132,11 @@ ClockSetup ClockSetup_instance[1];
 void ClockSetup_Start(bool hemisphere) {ClockSetup_instance[hemisphere].BaseStart(hemisphere);}
 void ClockSetup_Controller(bool hemisphere, bool forwarding) {ClockSetup_instance[hemisphere].BaseController(forwarding);}
 void ClockSetup_View(bool hemisphere) {ClockSetup_instance[hemisphere].BaseView();}
+uint32_t ClockSetup_ViewHash(bool hemisphere) {return ClockSetup_instance[hemisphere].ViewHash();}
 void ClockSetup_OnButtonPress(bool hemisphere) {ClockSetup_instance[hemisphere].OnButtonPress();}
 void ClockSetup_OnEncoderMove(bool hemisphere, int direction) {ClockSetup_instance[hemisphere].OnEncoderMove(direction);}
 void ClockSetup_ToggleHelpScreen(bool hemisphere) {ClockSetup_instance[hemisphere].HelpScreen();}
 uint32_t ClockSetup_OnDataRequest(bool hemisphere) {return ClockSetup_instance[hemisphere].OnDataRequest();}
 void ClockSetup_OnDataReceive(bool hemisphere, uint32_t data) {ClockSetup_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APP_HEMISPHERE
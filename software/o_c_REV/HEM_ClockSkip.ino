@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_ClockSkip
+
 class ClockSkip : public HemisphereApplet {
 public:
 
@@ -131,6 +133,10 @@ void ClockSkip_View(bool hemisphere) {
     ClockSkip_instance[hemisphere].BaseView();
 }
 
+uint32_t ClockSkip_ViewHash(bool hemisphere) {
+    return ClockSkip_instance[hemisphere].ViewHash();
+}
+
 void ClockSkip_OnButtonPress(bool hemisphere) {
     ClockSkip_instance[hemisphere].OnButtonPress();
 }
@@ -150,3 +156,5 @@ uint32_t ClockSkip_OnDataRequest(bool hemisphere) {
 void ClockSkip_OnDataReceive(bool hemisphere, uint32_t data) {
     ClockSkip_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_ClockSkip
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Compare
+
 #define HEM_COMPARE_MAX_VALUE 255
 
 class Compare : public HemisphereApplet {
@@ -123,6 +125,10 @@ void Compare_View(bool hemisphere) {
     Compare_instance[hemisphere].BaseView();
 }
 
+uint32_t Compare_ViewHash(bool hemisphere) {
+    return Compare_instance[hemisphere].ViewHash();
+}
+
 void Compare_OnButtonPress(bool hemisphere) {
     Compare_instance[hemisphere].OnButtonPress();
 }
@@ -142,3 +148,5 @@ uint32_t Compare_OnDataRequest(bool hemisphere) {
 void Compare_OnDataReceive(bool hemisphere, uint32_t data) {
     Compare_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Compare
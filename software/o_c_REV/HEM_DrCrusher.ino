@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_DrCrusher
+
 const char* const crusher_rate[8] = {
     "16.7", "8.3", "5.6", "4.2", "3.3", "2.1", "1", ".5"
 };
@@ -144,8 +146,11 @@ DrCrusher DrCrusher_instance[2];
 void DrCrusher_Start(bool hemisphere) {DrCrusher_instance[hemisphere].BaseStart(hemisphere);}
 void DrCrusher_Controller(bool hemisphere, bool forwarding) {DrCrusher_instance[hemisphere].BaseController(forwarding);}
 void DrCrusher_View(bool hemisphere) {DrCrusher_instance[hemisphere].BaseView();}
+uint32_t DrCrusher_ViewHash(bool hemisphere) {return DrCrusher_instance[hemisphere].ViewHash();}
 void DrCrusher_OnButtonPress(bool hemisphere) {DrCrusher_instance[hemisphere].OnButtonPress();}
 void DrCrusher_OnEncoderMove(bool hemisphere, int direction) {DrCrusher_instance[hemisphere].OnEncoderMove(direction);}
 void DrCrusher_ToggleHelpScreen(bool hemisphere) {DrCrusher_instance[hemisphere].HelpScreen();}
 uint32_t DrCrusher_OnDataRequest(bool hemisphere) {return DrCrusher_instance[hemisphere].OnDataRequest();}
 void DrCrusher_OnDataReceive(bool hemisphere, uint32_t data) {DrCrusher_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_DrCrusher
@@ -24,6 +24,8 @@
 #include "braids_quantizer_scales.h"
 #include "OC_scales.h"
 
+#if ENABLE_APPLET_DualQuant
+
 class DualQuant : public HemisphereApplet {
 public:
 
@@ -180,6 +182,10 @@ void DualQuant_View(bool hemisphere) {
     DualQuant_instance[hemisphere].BaseView();
 }
 
+uint32_t DualQuant_ViewHash(bool hemisphere) {
+    return DualQuant_instance[hemisphere].ViewHash();
+}
+
 void DualQuant_OnButtonPress(bool hemisphere) {
     DualQuant_instance[hemisphere].OnButtonPress();
 }
@@ -199,3 +205,5 @@ uint32_t DualQuant_OnDataRequest(bool hemisphere) {
 void DualQuant_OnDataReceive(bool hemisphere, uint32_t data) {
     DualQuant_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_DualQuant
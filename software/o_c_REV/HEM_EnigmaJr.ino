@@ -29,6 +29,8 @@
 #include "enigma/TuringMachineState.h"
 #include "enigma/EnigmaOutput.h"
 
+#if ENABLE_APPLET_EnigmaJr
+
 class EnigmaJr : public HemisphereApplet {
 public:
 
@@ -214,8 +216,11 @@ EnigmaJr EnigmaJr_instance[2];
 void EnigmaJr_Start(bool hemisphere) {EnigmaJr_instance[hemisphere].BaseStart(hemisphere);}
 void EnigmaJr_Controller(bool hemisphere, bool forwarding) {EnigmaJr_instance[hemisphere].BaseController(forwarding);}
 void EnigmaJr_View(bool hemisphere) {EnigmaJr_instance[hemisphere].BaseView();}
+uint32_t EnigmaJr_ViewHash(bool hemisphere) {return EnigmaJr_instance[hemisphere].ViewHash();}
 void EnigmaJr_OnButtonPress(bool hemisphere) {EnigmaJr_instance[hemisphere].OnButtonPress();}
 void EnigmaJr_OnEncoderMove(bool hemisphere, int direction) {EnigmaJr_instance[hemisphere].OnEncoderMove(direction);}
 void EnigmaJr_ToggleHelpScreen(bool hemisphere) {EnigmaJr_instance[hemisphere].HelpScreen();}
 uint32_t EnigmaJr_OnDataRequest(bool hemisphere) {return EnigmaJr_instance[hemisphere].OnDataRequest();}
 void EnigmaJr_OnDataReceive(bool hemisphere, uint32_t data) {EnigmaJr_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_EnigmaJr
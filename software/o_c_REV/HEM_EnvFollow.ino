@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_EnvFollow
+
 #define HEM_ENV_FOLLOWER_SAMPLES 166
 
 class EnvFollow : public HemisphereApplet {
@@ -146,8 +148,11 @@ EnvFollow EnvFollow_instance[2];
 void EnvFollow_Start(bool hemisphere) {EnvFollow_instance[hemisphere].BaseStart(hemisphere);}
 void EnvFollow_Controller(bool hemisphere, bool forwarding) {EnvFollow_instance[hemisphere].BaseController(forwarding);}
 void EnvFollow_View(bool hemisphere) {EnvFollow_instance[hemisphere].BaseView();}
+uint32_t EnvFollow_ViewHash(bool hemisphere) {return EnvFollow_instance[hemisphere].ViewHash();}
 void EnvFollow_OnButtonPress(bool hemisphere) {EnvFollow_instance[hemisphere].OnButtonPress();}
 void EnvFollow_OnEncoderMove(bool hemisphere, int direction) {EnvFollow_instance[hemisphere].OnEncoderMove(direction);}
 void EnvFollow_ToggleHelpScreen(bool hemisphere) {EnvFollow_instance[hemisphere].HelpScreen();}
 uint32_t EnvFollow_OnDataRequest(bool hemisphere) {return EnvFollow_instance[hemisphere].OnDataRequest();}
 void EnvFollow_OnDataReceive(bool hemisphere, uint32_t data) {EnvFollow_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_EnvFollow
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_GateDelay
+
 class GateDelay : public HemisphereApplet {
 public:
 
@@ -161,6 +163,10 @@ void GateDelay_View(bool hemisphere) {
     GateDelay_instance[hemisphere].BaseView();
 }
 
+uint32_t GateDelay_ViewHash(bool hemisphere) {
+    return GateDelay_instance[hemisphere].ViewHash();
+}
+
 void GateDelay_OnButtonPress(bool hemisphere) {
     GateDelay_instance[hemisphere].OnButtonPress();
 }
@@ -180,3 +186,5 @@ uint32_t GateDelay_OnDataRequest(bool hemisphere) {
 void GateDelay_OnDataReceive(bool hemisphere, uint32_t data) {
     GateDelay_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_GateDelay
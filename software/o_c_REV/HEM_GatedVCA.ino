@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_GatedVCA
+
 class GatedVCA : public HemisphereApplet {
 public:
 
@@ -107,6 +109,10 @@ void GatedVCA_View(bool hemisphere) {
     GatedVCA_instance[hemisphere].BaseView();
 }
 
+uint32_t GatedVCA_ViewHash(bool hemisphere) {
+    return GatedVCA_instance[hemisphere].ViewHash();
+}
+
 void GatedVCA_OnButtonPress(bool hemisphere) {
     GatedVCA_instance[hemisphere].OnButtonPress();
 }
@@ -126,3 +132,5 @@ uint32_t GatedVCA_OnDataRequest(bool hemisphere) {
 void GatedVCA_OnDataReceive(bool hemisphere, uint32_t data) {
     GatedVCA_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_GatedVCA
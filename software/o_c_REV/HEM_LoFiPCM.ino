@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_LoFiPCM
+
 #define HEM_LOFI_PCM_BUFFER_SIZE 2048
 #define HEM_LOFI_PCM_SPEED 8
 #define LOFI_PCM2CV(S) ((uint32_t)S << 8) - 32767;
@@ -188,6 +190,10 @@ void LoFiPCM_View(bool hemisphere) {
     LoFiPCM_instance[hemisphere].BaseView();
 }
 
+uint32_t LoFiPCM_ViewHash(bool hemisphere) {
+    return LoFiPCM_instance[hemisphere].ViewHash();
+}
+
 void LoFiPCM_OnButtonPress(bool hemisphere) {
     LoFiPCM_instance[hemisphere].OnButtonPress();
 }
@@ -207,3 +213,5 @@ uint32_t LoFiPCM_OnDataRequest(bool hemisphere) {
 void LoFiPCM_OnDataReceive(bool hemisphere, uint32_t data) {
     LoFiPCM_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_LoFiPCM
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Logic
+
 // Logical gate functions and typedef to function pointer
 #define HEMISPHERE_NUMBER_OF_LOGIC 7
 bool hem_AND(bool s1, bool s2) {return s1 & s2;}
@@ -165,6 +167,10 @@ void Logic_View(bool hemisphere) {
     Logic_instance[hemisphere].BaseView();
 }
 
+uint32_t Logic_ViewHash(bool hemisphere) {
+    return Logic_instance[hemisphere].ViewHash();
+}
+
 void Logic_OnButtonPress(bool hemisphere) {
     Logic_instance[hemisphere].OnButtonPress();
 }
@@ -184,3 +190,5 @@ uint32_t Logic_OnDataRequest(bool hemisphere) {
 void Logic_OnDataReceive(bool hemisphere, uint32_t data) {
     Logic_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Logic
@@ -25,6 +25,8 @@
 #include "util/util_math.h"
 #include "HSLorenzGeneratorManager.h" // Singleton Lorenz manager
 
+#if ENABLE_APPLET_LowerRenz
+
 class LowerRenz : public HemisphereApplet {
 public:
 
@@ -149,6 +151,10 @@ void LowerRenz_View(bool hemisphere) {
     LowerRenz_instance[hemisphere].BaseView();
 }
 
+uint32_t LowerRenz_ViewHash(bool hemisphere) {
+    return LowerRenz_instance[hemisphere].ViewHash();
+}
+
 void LowerRenz_OnButtonPress(bool hemisphere) {
     LowerRenz_instance[hemisphere].OnButtonPress();
 }
@@ -168,3 +174,5 @@ uint32_t LowerRenz_OnDataRequest(bool hemisphere) {
 void LowerRenz_OnDataReceive(bool hemisphere, uint32_t data) {
     LowerRenz_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_LowerRenz
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_MixerBal
+
 #define MIXER_MAX_VALUE 255
 
 class MixerBal : public HemisphereApplet {
@@ -29,17 +31,15 @@ public:
 
     void Start() {
         balance = 127;
+        UpdateWeights();
     }
 
     void Controller() {
-        int signal1 = In(0);
-        int signal2 = In(1);
-
-        int mix1 = Proportion(balance, MIXER_MAX_VALUE, signal2)
-                 + Proportion(MIXER_MAX_VALUE - balance, MIXER_MAX_VALUE, signal1);
-
-        int mix2 = Proportion(balance, MIXER_MAX_VALUE, signal1)
-                 + Proportion(MIXER_MAX_VALUE - balance, MIXER_MAX_VALUE, signal2);
+        // mix1 = signal1 * (1 - balance) + signal2 * balance, and mix2 is the
+        // complement, so both are a single dual multiply-add of the packed signals
+        simd2::int16x2 signals = simd2::pack(In(0), In(1));
+        int mix1 = simfloat2int(simd2::dot(weights, signals));
+        int mix2 = simfloat2int(simd2::dotx(weights, signals));
 
         Out(0, mix1);
         Out(1, mix2);
@@ -56,6 +56,7 @@ public:
 
     void OnEncoderMove(int direction) {
         balance = constrain(balance + direction, 0, 255);
+        UpdateWeights();
     }
         
     uint32_t OnDataRequest() {
@@ -66,6 +67,7 @@ public:
 
     void OnDataReceive(uint32_t data) {
         balance = Unpack(data, PackLocation {0,8});
+        UpdateWeights();
     }
 
 protected:
@@ -81,7 +83,13 @@ protected:
 private:
     int cursor;
     int balance;
-    
+    simd2::int16x2 weights; // simfloat weights for signal 1 (lo) and signal 2 (hi)
+
+    void UpdateWeights() {
+        weights = simd2::pack(int2simfloat(MIXER_MAX_VALUE - balance) / MIXER_MAX_VALUE,
+                              int2simfloat(balance) / MIXER_MAX_VALUE);
+    }
+
     void DrawBalanceIndicator() {
         gfxFrame(1, 15, 62, 6);
         int x = Proportion(balance, MIXER_MAX_VALUE, 62);
@@ -112,6 +120,10 @@ void MixerBal_View(bool hemisphere) {
     MixerBal_instance[hemisphere].BaseView();
 }
 
+uint32_t MixerBal_ViewHash(bool hemisphere) {
+    return MixerBal_instance[hemisphere].ViewHash();
+}
+
 void MixerBal_OnButtonPress(bool hemisphere) {
     MixerBal_instance[hemisphere].OnButtonPress();
 }
@@ -131,3 +143,5 @@ uint32_t MixerBal_OnDataRequest(bool hemisphere) {
 void MixerBal_OnDataReceive(bool hemisphere, uint32_t data) {
     MixerBal_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_MixerBal
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Palimpsest
+
 #define HEM_PALIMPSEST_MAX_VALUE 100
 
 class Palimpsest : public HemisphereApplet {
@@ -189,6 +191,10 @@ void Palimpsest_View(bool hemisphere) {
     Palimpsest_instance[hemisphere].BaseView();
 }
 
+uint32_t Palimpsest_ViewHash(bool hemisphere) {
+    return Palimpsest_instance[hemisphere].ViewHash();
+}
+
 void Palimpsest_OnButtonPress(bool hemisphere) {
     Palimpsest_instance[hemisphere].OnButtonPress();
 }
@@ -208,3 +214,5 @@ uint32_t Palimpsest_OnDataRequest(bool hemisphere) {
 void Palimpsest_OnDataReceive(bool hemisphere, uint32_t data) {
     Palimpsest_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Palimpsest
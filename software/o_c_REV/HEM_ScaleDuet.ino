@@ -24,6 +24,8 @@
 #include "braids_quantizer_scales.h"
 #include "OC_scales.h"
 
+#if ENABLE_APPLET_ScaleDuet
+
 class ScaleDuet : public HemisphereApplet {
 public:
 
@@ -173,6 +175,10 @@ void ScaleDuet_View(bool hemisphere) {
     ScaleDuet_instance[hemisphere].BaseView();
 }
 
+uint32_t ScaleDuet_ViewHash(bool hemisphere) {
+    return ScaleDuet_instance[hemisphere].ViewHash();
+}
+
 void ScaleDuet_OnButtonPress(bool hemisphere) {
     ScaleDuet_instance[hemisphere].OnButtonPress();
 }
@@ -192,3 +198,5 @@ uint32_t ScaleDuet_OnDataRequest(bool hemisphere) {
 void ScaleDuet_OnDataReceive(bool hemisphere, uint32_t data) {
     ScaleDuet_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_ScaleDuet
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Schmitt
+
 #define SCHMITT_FLASH_SPEED 4000
 
 class Schmitt : public HemisphereApplet {
@@ -173,6 +175,10 @@ void Schmitt_View(bool hemisphere) {
     Schmitt_instance[hemisphere].BaseView();
 }
 
+uint32_t Schmitt_ViewHash(bool hemisphere) {
+    return Schmitt_instance[hemisphere].ViewHash();
+}
+
 void Schmitt_OnButtonPress(bool hemisphere) {
     Schmitt_instance[hemisphere].OnButtonPress();
 }
@@ -192,3 +198,5 @@ uint32_t Schmitt_OnDataRequest(bool hemisphere) {
 void Schmitt_OnDataReceive(bool hemisphere, uint32_t data) {
     Schmitt_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Schmitt
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Scope
+
 const uint8_t HEM_PPQN_VALUES[] = {1, 2, 4, 8, 16, 24};
 
 class Scope : public HemisphereApplet {
@@ -33,6 +35,7 @@ public:
         sample_ticks = 320;
         freeze = 0;
         last_scope_tick = 0;
+        OC::ADC::hold_history(scope_channel(), false);
     }
 
     void Controller() {
@@ -55,20 +58,14 @@ public:
 
         if (!freeze) {
             last_cv = In(1);
-
-            if (--sample_countdown < 1) {
-                sample_countdown = sample_ticks;
-                if (++sample_num > 63) sample_num = 0;
-                int sample = Proportion(In(0), HEMISPHERE_MAX_CV, 128);
-                sample = constrain(sample, -128, 127) + 127;
-                snapshot[sample_num] = (uint8_t)sample;
-            }
-
             ForEachChannel(ch) Out(ch, In(ch));
         }
     }
 
     void View() {
+        // The scope is drawn from the ADC history, which is decimated to the
+        // nearest power of two of the sample time
+        OC::ADC::set_history_decimation(scope_channel(), history_decimation());
         gfxHeader(applet_name());
         DrawBPM();
         DrawInput1();
@@ -80,11 +77,13 @@ public:
 
     void OnButtonPress() {
         freeze = 1 - freeze;
+        OC::ADC::hold_history(scope_channel(), freeze);
     }
 
     void OnEncoderMove(int direction) {
-        if (sample_ticks < 32) sample_ticks += direction;
-        else sample_ticks += direction * 10;
+        // Only powers of two are distinct, see View
+        if (direction > 0) sample_ticks *= 2;
+        else sample_ticks /= 2;
         sample_ticks = constrain(sample_ticks, 2, 64000);
         last_encoder_move = OC::CORE::ticks;
     }
@@ -121,13 +120,29 @@ private:
     bool freeze;
 
     // Scope
-    uint8_t snapshot[64];
     int sample_ticks; // Ticks between samples
-    int sample_countdown; // Last time a sample was taken
-    int sample_num; // Current sample number at the start
     int last_encoder_move; // The last the the sample_ticks value was changed
     int last_scope_tick; // Used to auto-calculate sample countdown
 
+    ADC_CHANNEL scope_channel() {
+        return (ADC_CHANNEL)io_offset;
+    }
+
+    // Largest decimation with history samples at most sample_ticks apart;
+    // the channel's update rate depends on the scan schedule.
+    uint32_t history_decimation() {
+        const uint32_t rate = OC::ADC::scan_rate(scope_channel());
+        uint32_t decimation = 0;
+        while (decimation < OC::ADC::DeepHistory::kMaxDecimation
+               && (OC_CORE_ISR_FREQ << (decimation + 1)) <= sample_ticks * rate)
+            ++decimation;
+        return decimation;
+    }
+
+    int history_sample_ticks() {
+        return (OC_CORE_ISR_FREQ << OC::ADC::history_decimation(scope_channel())) / OC::ADC::scan_rate(scope_channel());
+    }
+
     // Icons
 
     void DrawBPM() {
@@ -139,16 +154,18 @@ private:
     }
 
     void DrawInput1() {
-        for (int s = 0; s < 64; s++)
+        const OC::ADC::DeepHistory::View history = OC::ADC::history_snapshot(scope_channel());
+        const size_t first = history.length - 64;
+        for (int x = 0; x < 64; x++)
         {
-            int x = s + sample_num;
-            if (x > 63) x -= 64;
-            int l = Proportion(snapshot[x], 255, 28);
+            int sample = Proportion(history[first + x], HEMISPHERE_MAX_CV, 128);
+            sample = constrain(sample, -128, 127) + 127;
+            int l = Proportion(sample, 255, 28);
             gfxPixel(x, (28 - l) + 24);
         }
 
         if (OC::CORE::ticks - last_encoder_move < 16667) {
-            gfxPrint(1, 26, sample_ticks);
+            gfxPrint(1, 26, history_sample_ticks());
         }
     }
 
@@ -183,6 +200,10 @@ void Scope_View(bool hemisphere) {
     Scope_instance[hemisphere].BaseView();
 }
 
+uint32_t Scope_ViewHash(bool hemisphere) {
+    return Scope_instance[hemisphere].ViewHash();
+}
+
 void Scope_OnButtonPress(bool hemisphere) {
     Scope_instance[hemisphere].OnButtonPress();
 }
@@ -202,3 +223,5 @@ uint32_t Scope_OnDataRequest(bool hemisphere) {
 void Scope_OnDataReceive(bool hemisphere, uint32_t data) {
     Scope_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Scope
@@ -20,6 +20,8 @@
 
 #include "HSMIDI.h"
 
+#if ENABLE_APPLET_Sequence5
+
 class Sequence5 : public HemisphereApplet {
 public:
 
@@ -172,6 +174,10 @@ void Sequence5_View(bool hemisphere) {
     Sequence5_instance[hemisphere].BaseView();
 }
 
+uint32_t Sequence5_ViewHash(bool hemisphere) {
+    return Sequence5_instance[hemisphere].ViewHash();
+}
+
 void Sequence5_OnButtonPress(bool hemisphere) {
     Sequence5_instance[hemisphere].OnButtonPress();
 }
@@ -191,3 +197,5 @@ uint32_t Sequence5_OnDataRequest(bool hemisphere) {
 void Sequence5_OnDataReceive(bool hemisphere, uint32_t data) {
     Sequence5_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Sequence5
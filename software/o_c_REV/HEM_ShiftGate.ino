@@ -1,3 +1,5 @@
+#if ENABLE_APPLET_ShiftGate
+
 class ShiftGate : public HemisphereApplet {
 public:
 
@@ -135,8 +137,11 @@ ShiftGate ShiftGate_instance[2];
 void ShiftGate_Start(bool hemisphere) {ShiftGate_instance[hemisphere].BaseStart(hemisphere);}
 void ShiftGate_Controller(bool hemisphere, bool forwarding) {ShiftGate_instance[hemisphere].BaseController(forwarding);}
 void ShiftGate_View(bool hemisphere) {ShiftGate_instance[hemisphere].BaseView();}
+uint32_t ShiftGate_ViewHash(bool hemisphere) {return ShiftGate_instance[hemisphere].ViewHash();}
 void ShiftGate_OnButtonPress(bool hemisphere) {ShiftGate_instance[hemisphere].OnButtonPress();}
 void ShiftGate_OnEncoderMove(bool hemisphere, int direction) {ShiftGate_instance[hemisphere].OnEncoderMove(direction);}
 void ShiftGate_ToggleHelpScreen(bool hemisphere) {ShiftGate_instance[hemisphere].HelpScreen();}
 uint32_t ShiftGate_OnDataRequest(bool hemisphere) {return ShiftGate_instance[hemisphere].OnDataRequest();}
 void ShiftGate_OnDataReceive(bool hemisphere, uint32_t data) {ShiftGate_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_ShiftGate
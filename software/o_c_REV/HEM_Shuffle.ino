@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Shuffle
+
 class Shuffle : public HemisphereApplet {
 public:
 
@@ -43,7 +45,7 @@ public:
         if (Clock(0)) {
             which = 1 - which;
             if (last_tick) {
-                tempo = tick - last_tick;
+                tempo = ClockPeriodTicks(0);
                 int16_t d = delay[which] + Proportion(DetentedIn(which), HEMISPHERE_MAX_CV, 100);
                 d = constrain(d, 0, 100);
                 uint32_t delay_ticks = Proportion(d, 100, tempo);
@@ -95,7 +97,7 @@ protected:
 private:
     int cursor;
     bool which; // The current clock state, 0=even, 1=odd
-    uint32_t last_tick; // For calculating tempo
+    uint32_t last_tick; // Tick of the last clock or reset
     uint32_t next_trigger; // The tick of the next scheduled trigger
     uint32_t tempo; // Calculated time between ticks
 
@@ -167,6 +169,10 @@ void Shuffle_View(bool hemisphere) {
     Shuffle_instance[hemisphere].BaseView();
 }
 
+uint32_t Shuffle_ViewHash(bool hemisphere) {
+    return Shuffle_instance[hemisphere].ViewHash();
+}
+
 void Shuffle_OnButtonPress(bool hemisphere) {
     Shuffle_instance[hemisphere].OnButtonPress();
 }
@@ -186,3 +192,5 @@ uint32_t Shuffle_OnDataRequest(bool hemisphere) {
 void Shuffle_OnDataReceive(bool hemisphere, uint32_t data) {
     Shuffle_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Shuffle
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_SkewedLFO
+
 #define HEM_LFO_HIGH 40000
 #define HEM_LFO_LOW 800
 #define HEM_LFO_MAX_VALUE 120
@@ -178,6 +180,10 @@ void SkewedLFO_View(bool hemisphere) {
     SkewedLFO_instance[hemisphere].BaseView();
 }
 
+uint32_t SkewedLFO_ViewHash(bool hemisphere) {
+    return SkewedLFO_instance[hemisphere].ViewHash();
+}
+
 void SkewedLFO_OnButtonPress(bool hemisphere) {
     SkewedLFO_instance[hemisphere].OnButtonPress();
 }
@@ -197,3 +203,5 @@ uint32_t SkewedLFO_OnDataRequest(bool hemisphere) {
 void SkewedLFO_OnDataReceive(bool hemisphere, uint32_t data) {
     SkewedLFO_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_SkewedLFO
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Slew
+
 #define HEM_SLEW_MAX_VALUE 200
 #define HEM_SLEW_MAX_TICKS 64000
 
@@ -29,38 +31,17 @@ public:
     }
 
     void Start() {
-        ForEachChannel(ch) signal[ch] = 0;
         rise = 50;
         fall = 50;
+        UpdateRates();
     }
 
     void Controller() {
         ForEachChannel(ch)
         {
-            simfloat input = int2simfloat(In(ch));
-            if (Gate(ch)) signal[ch] = input; // Defeat slew when channel's gate is high
-            if (input != signal[ch]) {
-
-                int segment = (input > signal[ch]) ? rise : fall;
-                simfloat remaining = input - signal[ch];
-
-                // The number of ticks it would take to get from 0 to HEMISPHERE_MAX_CV
-                int max_change = Proportion(segment, HEM_SLEW_MAX_VALUE, HEM_SLEW_MAX_TICKS);
-
-                // The number of ticks it would take to move the remaining amount at max_change
-                int ticks_to_remaining = Proportion(simfloat2int(remaining), HEMISPHERE_MAX_CV, max_change);
-                if (ticks_to_remaining < 0) ticks_to_remaining = -ticks_to_remaining;
-
-                simfloat delta;
-                if (ticks_to_remaining <= 0) {
-                    delta = remaining;
-                } else {
-                    if (ch == 1) ticks_to_remaining /= 2;
-                    delta = remaining / ticks_to_remaining;
-                }
-                signal[ch] += delta;
-            }
-            Out(ch, simfloat2int(signal[ch]));
+            int input = In(ch);
+            if (Gate(ch)) Out(ch, input); // Defeat slew when channel's gate is high
+            else SlewOut(ch, input, input > ViewOut(ch) ? rise_rate[ch] : fall_rate[ch]);
         }
     }
 
@@ -82,6 +63,7 @@ public:
             fall = constrain(fall += direction, 0, HEM_SLEW_MAX_VALUE);
             last_ms_value = Proportion(fall, HEM_SLEW_MAX_VALUE, HEM_SLEW_MAX_TICKS) / 17;
         }
+        UpdateRates();
         last_change_ticks = OC::CORE::ticks;
     }
         
@@ -95,6 +77,7 @@ public:
     void OnDataReceive(uint32_t data) {
         rise = Unpack(data, PackLocation {0,8});
         fall = Unpack(data, PackLocation {8,8});
+        UpdateRates();
     }
 
 protected:
@@ -110,11 +93,30 @@ protected:
 private:
     int rise; // Time to reach signal level if signal < 5V
     int fall; // Time to reach signal level if signal > 0V
-    simfloat signal[2]; // Current signal level for each channel
+    simfloat rise_rate[2]; // Slew rate for each channel (simfloat per tick)
+    simfloat fall_rate[2];
     int cursor; // 0 = Rise, 1 = Fall
     int last_ms_value;
     int last_change_ticks;
 
+    // The output slew itself runs in the DAC; segment is the number of ticks to
+    // get from 0 to HEMISPHERE_MAX_CV, and channel 2 is twice as fast.
+    void UpdateRates() {
+        simfloat rise_max = SegmentRate(rise);
+        simfloat fall_max = SegmentRate(fall);
+        ForEachChannel(ch)
+        {
+            rise_rate[ch] = rise_max << ch;
+            fall_rate[ch] = fall_max << ch;
+        }
+    }
+
+    simfloat SegmentRate(int segment) {
+        int max_change = Proportion(segment, HEM_SLEW_MAX_VALUE, HEM_SLEW_MAX_TICKS);
+        if (max_change <= 0) return int2simfloat(HEMISPHERE_MAX_CV * 2); // Immediate
+        return int2simfloat(HEMISPHERE_MAX_CV) / max_change;
+    }
+
     void DrawIndicator() {
         // Rise portion
         int r_x = Proportion(rise, 200, 31);
@@ -165,6 +167,10 @@ void Slew_View(bool hemisphere) {
     Slew_instance[hemisphere].BaseView();
 }
 
+uint32_t Slew_ViewHash(bool hemisphere) {
+    return Slew_instance[hemisphere].ViewHash();
+}
+
 void Slew_OnButtonPress(bool hemisphere) {
     Slew_instance[hemisphere].OnButtonPress();
 }
@@ -184,3 +190,5 @@ uint32_t Slew_OnDataRequest(bool hemisphere) {
 void Slew_OnDataReceive(bool hemisphere, uint32_t data) {
     Slew_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Slew
@@ -24,6 +24,8 @@
 #include "braids_quantizer_scales.h"
 #include "OC_scales.h"
 
+#if ENABLE_APPLET_Squanch
+
 class Squanch : public HemisphereApplet {
 public:
 
@@ -44,7 +46,9 @@ public:
         }
 
         if (continuous || EndOfADCLag(0)) {
-            int32_t pitch = In(0);
+            // Quantize once; the shifts are applied to the quantized note, so
+            // the quantizer keeps its hysteresis for the input
+            int32_t quantized = quantizer.Process(In(0), 0, 0);
 
             ForEachChannel(ch)
             {
@@ -52,9 +56,8 @@ public:
                 // output, the output is raised by one octave when Digital 2 is gated.
                 int32_t shift_alt = (ch == 1) ? DetentedIn(1) : Gate(1) * (12 << 7);
 
-                int32_t quantized = quantizer.Process(pitch, 0, shift[ch]);
-                Out(ch, quantized + shift_alt);
-                last_note[ch] = quantized;
+                last_note[ch] = ShiftNote(quantized, shift[ch]);
+                Out(ch, last_note[ch] + shift_alt);
             }
         }
 
@@ -116,6 +119,14 @@ private:
     int scale;
     int16_t shift[2];
 
+    // Same as Process with transpose = shift, for the note just quantized
+    int32_t ShiftNote(int32_t quantized, int shift) {
+        if (!shift || !quantizer.enabled()) return quantized;
+        int32_t note = quantizer.note_number();
+        int32_t shifted = constrain(note + shift, 1, 126);
+        return quantized + quantizer.Lookup(shifted) - quantizer.Lookup(note);
+    }
+
     void DrawInterface() {
         const uint8_t notes[2][8] = {{0xc0, 0xe0, 0xe0, 0xe0, 0x7f, 0x02, 0x14, 0x08},
                                      {0xc0, 0xa0, 0xa0, 0xa0, 0x7f, 0x00, 0x00, 0x00}};
@@ -171,8 +182,11 @@ Squanch Squanch_instance[2];
 void Squanch_Start(bool hemisphere) {Squanch_instance[hemisphere].BaseStart(hemisphere);}
 void Squanch_Controller(bool hemisphere, bool forwarding) {Squanch_instance[hemisphere].BaseController(forwarding);}
 void Squanch_View(bool hemisphere) {Squanch_instance[hemisphere].BaseView();}
+uint32_t Squanch_ViewHash(bool hemisphere) {return Squanch_instance[hemisphere].ViewHash();}
 void Squanch_OnButtonPress(bool hemisphere) {Squanch_instance[hemisphere].OnButtonPress();}
 void Squanch_OnEncoderMove(bool hemisphere, int direction) {Squanch_instance[hemisphere].OnEncoderMove(direction);}
 void Squanch_ToggleHelpScreen(bool hemisphere) {Squanch_instance[hemisphere].HelpScreen();}
 uint32_t Squanch_OnDataRequest(bool hemisphere) {return Squanch_instance[hemisphere].OnDataRequest();}
 void Squanch_OnDataReceive(bool hemisphere, uint32_t data) {Squanch_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_Squanch
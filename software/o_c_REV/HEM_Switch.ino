@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Switch
+
 class Switch : public HemisphereApplet {
 public:
 
@@ -121,6 +123,10 @@ void Switch_View(bool hemisphere) {
     Switch_instance[hemisphere].BaseView();
 }
 
+uint32_t Switch_ViewHash(bool hemisphere) {
+    return Switch_instance[hemisphere].ViewHash();
+}
+
 void Switch_OnButtonPress(bool hemisphere) {
     Switch_instance[hemisphere].OnButtonPress();
 }
@@ -140,3 +146,5 @@ uint32_t Switch_OnDataRequest(bool hemisphere) {
 void Switch_OnDataReceive(bool hemisphere, uint32_t data) {
     Switch_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Switch
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_TLNeuron
+
 // How fast the axon pulses when active
 #define HEM_TLN_ACTIVE_TICKS 1500
 
@@ -178,6 +180,10 @@ void TLNeuron_View(bool hemisphere) {
     TLNeuron_instance[hemisphere].BaseView();
 }
 
+uint32_t TLNeuron_ViewHash(bool hemisphere) {
+    return TLNeuron_instance[hemisphere].ViewHash();
+}
+
 void TLNeuron_OnButtonPress(bool hemisphere) {
     TLNeuron_instance[hemisphere].OnButtonPress();
 }
@@ -197,3 +203,5 @@ uint32_t TLNeuron_OnDataRequest(bool hemisphere) {
 void TLNeuron_OnDataReceive(bool hemisphere, uint32_t data) {
     TLNeuron_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_TLNeuron
@@ -30,6 +30,9 @@
 #include "braids_quantizer.h"
 #include "braids_quantizer_scales.h"
 #include "OC_scales.h"
+
+#if ENABLE_APPLET_TM
+
 #define TM_MAX_SCALE 63
 #define TM_MIN_LENGTH 2
 #define TM_MAX_LENGTH 16
@@ -207,6 +210,10 @@ void TM_View(bool hemisphere) {
     TM_instance[hemisphere].BaseView();
 }
 
+uint32_t TM_ViewHash(bool hemisphere) {
+    return TM_instance[hemisphere].ViewHash();
+}
+
 void TM_OnButtonPress(bool hemisphere) {
     TM_instance[hemisphere].OnButtonPress();
 }
@@ -226,3 +233,5 @@ uint32_t TM_OnDataRequest(bool hemisphere) {
 void TM_OnDataReceive(bool hemisphere, uint32_t data) {
     TM_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_TM
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Trending
+
 #define TRENDING_MAX_SENS 124
 
 const char* const Trending_assignments[6] = {
@@ -197,8 +199,11 @@ Trending Trending_instance[2];
 void Trending_Start(bool hemisphere) {Trending_instance[hemisphere].BaseStart(hemisphere);}
 void Trending_Controller(bool hemisphere, bool forwarding) {Trending_instance[hemisphere].BaseController(forwarding);}
 void Trending_View(bool hemisphere) {Trending_instance[hemisphere].BaseView();}
+uint32_t Trending_ViewHash(bool hemisphere) {return Trending_instance[hemisphere].ViewHash();}
 void Trending_OnButtonPress(bool hemisphere) {Trending_instance[hemisphere].OnButtonPress();}
 void Trending_OnEncoderMove(bool hemisphere, int direction) {Trending_instance[hemisphere].OnEncoderMove(direction);}
 void Trending_ToggleHelpScreen(bool hemisphere) {Trending_instance[hemisphere].HelpScreen();}
 uint32_t Trending_OnDataRequest(bool hemisphere) {return Trending_instance[hemisphere].OnDataRequest();}
 void Trending_OnDataReceive(bool hemisphere, uint32_t data) {Trending_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_Trending
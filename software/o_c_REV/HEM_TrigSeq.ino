@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_TrigSeq
+
 class TrigSeq : public HemisphereApplet {
 public:
 
@@ -181,6 +183,10 @@ void TrigSeq_View(bool hemisphere) {
     TrigSeq_instance[hemisphere].BaseView();
 }
 
+uint32_t TrigSeq_ViewHash(bool hemisphere) {
+    return TrigSeq_instance[hemisphere].ViewHash();
+}
+
 void TrigSeq_OnButtonPress(bool hemisphere) {
     TrigSeq_instance[hemisphere].OnButtonPress();
 }
@@ -200,3 +206,5 @@ uint32_t TrigSeq_OnDataRequest(bool hemisphere) {
 void TrigSeq_OnDataReceive(bool hemisphere, uint32_t data) {
     TrigSeq_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_TrigSeq
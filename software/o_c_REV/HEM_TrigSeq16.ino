@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_TrigSeq16
+
 class TrigSeq16 : public HemisphereApplet {
 public:
 
@@ -184,6 +186,10 @@ void TrigSeq16_View(bool hemisphere) {
     TrigSeq16_instance[hemisphere].BaseView();
 }
 
+uint32_t TrigSeq16_ViewHash(bool hemisphere) {
+    return TrigSeq16_instance[hemisphere].ViewHash();
+}
+
 void TrigSeq16_OnButtonPress(bool hemisphere) {
     TrigSeq16_instance[hemisphere].OnButtonPress();
 }
@@ -203,3 +209,5 @@ uint32_t TrigSeq16_OnDataRequest(bool hemisphere) {
 void TrigSeq16_OnDataReceive(bool hemisphere, uint32_t data) {
     TrigSeq16_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_TrigSeq16
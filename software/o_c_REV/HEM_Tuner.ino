@@ -21,12 +21,15 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-// Tuner can only work in the right hemisphere because the frequecy input is on
-// CV4. However, when the screen is flipped, Tuner can only work in the right
-// hemisphere. So there are various checks for the FLIP_180 compile-time option
-// in this code.
+#if ENABLE_APPLET_Tuner
 
-static constexpr double HEM_TUNER_AaboveMidCtoC0 = 0.03716272234383494188492;
+// Frequencies come from the core frequency counters, so any of the
+// hemisphere's digital or CV inputs can be used. Digital inputs are timed
+// from the edge timestamps; CV inputs count zero crossings, so they are
+// limited to half the ADC scan rate.
+
+#define HEM_TUNER_SOURCES 4
+#define HEM_TUNER_A4_ABOVE_C0 57000 // In tenths of a cent
 
 class Tuner : public HemisphereApplet {
 public:
@@ -37,50 +40,21 @@ public:
 
     void Start() {
         A4_Hz = 440;
-#ifdef FLIP_180
-        if (hemisphere == 0) {
-#else
-        if (hemisphere == 1) {
-#endif
-            FreqMeasure.begin();
-        }
+        source = 1; // Second digital input, as the original FreqMeasure pin
         AllowRestart();
     }
 
     void Controller() {
-#ifdef FLIP_180
-        if (hemisphere == 0 && FreqMeasure.available())
-#else
-        if (hemisphere == 1 && FreqMeasure.available())
-#endif
-        {
-            // average several readings together
-            freq_sum_ = freq_sum_ + FreqMeasure.read();
-            freq_count_ = freq_count_ + 1;
-
-            if (milliseconds_since_last_freq_ > 750) {
-                frequency_ = FreqMeasure.countToFrequency(freq_sum_ / freq_count_);
-                freq_sum_ = 0;
-                freq_count_ = 0;
-                milliseconds_since_last_freq_ = 0;
-            }
-        } else if (milliseconds_since_last_freq_ > 100000) {
-            frequency_ = 0.0f;
-        }
+        millihertz = get_frequency();
     }
 
     void View() {
         gfxHeader(applet_name());
-#ifdef FLIP_180
-        if (hemisphere == 0) DrawTuner();
-#else
-        if (hemisphere == 1) DrawTuner();
-#endif
-        else DrawWarning();
+        DrawTuner();
     }
 
     void OnButtonPress() {
-        Start();
+        if (++source >= HEM_TUNER_SOURCES) source = 0;
     }
 
     void OnEncoderMove(int direction) {
@@ -90,55 +64,40 @@ public:
     uint32_t OnDataRequest() {
         uint32_t data = 0;
         Pack(data, PackLocation {0,16}, A4_Hz);
+        Pack(data, PackLocation {16,2}, source ^ 1); // Older saves have 0 here
         return data;
     }
 
     void OnDataReceive(uint32_t data) {
         A4_Hz = Unpack(data, PackLocation {0,16});
+        source = Unpack(data, PackLocation {16,2}) ^ 1;
     }
 
 protected:
     void SetHelp() {
-        if (hemisphere == 1) {
-#ifdef FLIP_180
-            help[HEMISPHERE_HELP_DIGITALS] = "1=Input";
-#else
-            help[HEMISPHERE_HELP_DIGITALS] = "2=Input";
-#endif
-            help[HEMISPHERE_HELP_CVS]      = "";
-            help[HEMISPHERE_HELP_OUTS]     = "";
-            help[HEMISPHERE_HELP_ENCODER]  = "A4 Hz P=Reset";
-        } else {
-            help[HEMISPHERE_HELP_DIGITALS] = "Due to hardware";
-            help[HEMISPHERE_HELP_CVS]      = "constraints, the";
-            help[HEMISPHERE_HELP_OUTS]     = "Tuner must run in";
-#ifdef FLIP_180
-            help[HEMISPHERE_HELP_ENCODER]  = "left hemisphere";
-#else
-            help[HEMISPHERE_HELP_ENCODER]  = "right hemisphere";
-#endif
-        }
+        //                               "------------------" <-- Size Guide
+        help[HEMISPHERE_HELP_DIGITALS] = "1,2=Input";
+        help[HEMISPHERE_HELP_CVS]      = "1,2=Input";
+        help[HEMISPHERE_HELP_OUTS]     = "";
+        help[HEMISPHERE_HELP_ENCODER]  = "A4 Hz P=Input";
     }
     
 private:
-    // Port from References
-    double freq_sum_;
-    uint32_t freq_count_;
-    float frequency_ ;
-    elapsedMillis milliseconds_since_last_freq_;
     int A4_Hz; // Tuning reference
+    int source; // 0,1 = Digital 1,2; 2,3 = CV 1,2
+    uint32_t millihertz;
 
     void DrawTuner() {
-        float frequency_ = get_frequency() ;
-        float c0_freq_ = get_C0_freq() ;
-
-        int32_t deviation = round(12000.0 * log2f(frequency_ / c0_freq_)) + 500;
-        int8_t octave = deviation / 12000;
-        int8_t note = (deviation - (octave * 12000)) / 1000;
-        note = constrain(note, 0, 12);
-        int32_t residual = ((deviation - ((octave - 1) * 12000)) % 1000) - 500;
+        if (millihertz) {
+            // Tenths of a cent above C0, plus half a semitone for rounding to
+            // the nearest note
+            int32_t cents = util::frequency_cents(millihertz, A4_Hz * 1000);
+            int32_t deviation = ((cents * 10) >> 8) + HEM_TUNER_A4_ABOVE_C0 + 500;
+            int8_t octave = deviation / 12000;
+            int8_t note = (deviation - (octave * 12000)) / 1000;
+            note = constrain(note, 0, 12);
+            int32_t residual = ((deviation - ((octave - 1) * 12000)) % 1000) - 500;
 
-        if (frequency_ > 0.0) {
             gfxPrint(20, 30, OC::Strings::note_names[note]);
             gfxPrint(" ");
             gfxPrint(octave);
@@ -171,41 +130,27 @@ private:
             }
 
             // Draw frequency
-            const int f = int(floor(frequency_ * 100));
-            const int value = f / 100;
-            const int cents = f % 100;
+            const int value = millihertz / 1000;
+            const int hundredths = (millihertz / 10) % 100;
             gfxPrint(6 + pad(10000, value), 54, value);
             gfxPrint(".");
-            if (cents < 10) gfxPrint("0");
-            gfxPrint(cents);
+            if (hundredths < 10) gfxPrint("0");
+            gfxPrint(hundredths);
         }
 
         gfxPrint(1, 15, "A4= ");
         gfxPrint(A4_Hz);
         gfxPrint(" Hz");
         gfxCursor(25, 23, 36);
+
+        gfxPrint(1, 46, source < 2 ? "TR" : "CV");
+        gfxPrint(hemisphere * 2 + (source & 1) + 1);
     }
-    
-#ifdef FLIP_180
-    void DrawWarning() {
-        gfxPrint(1, 15, "Tuner goes");
-        gfxPrint(1, 25, "in left");
-        gfxPrint(1, 35, "hemisphere");
-        gfxPrint(1, 45, "<--");
-    }
-#else
-    void DrawWarning() {
-        gfxPrint(1, 15, "Tuner goes");
-        gfxPrint(1, 25, "in right");
-        gfxPrint(1, 35, "hemisphere");
-        gfxPrint(1, 45, "       -->");
-    }
-#endif
 
-    float get_frequency() {return frequency_;}
-    
-    float get_C0_freq() {
-        return(static_cast<float>(A4_Hz * HEM_TUNER_AaboveMidCtoC0));
+    uint32_t get_frequency() {
+        int input = hemisphere * 2 + (source & 1);
+        if (source < 2) return OC::DigitalInputs::frequency(static_cast<OC::DigitalInput>(input));
+        return OC::ADC::frequency(static_cast<ADC_CHANNEL>(input));
     }
 };
 
@@ -232,6 +177,10 @@ void Tuner_View(bool hemisphere) {
     Tuner_instance[hemisphere].BaseView();
 }
 
+uint32_t Tuner_ViewHash(bool hemisphere) {
+    return Tuner_instance[hemisphere].ViewHash();
+}
+
 void Tuner_OnButtonPress(bool hemisphere) {
     Tuner_instance[hemisphere].OnButtonPress();
 }
@@ -251,3 +200,5 @@ uint32_t Tuner_OnDataRequest(bool hemisphere) {
 void Tuner_OnDataReceive(bool hemisphere, uint32_t data) {
     Tuner_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_Tuner
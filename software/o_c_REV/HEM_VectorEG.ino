@@ -21,6 +21,8 @@
 #include "vector_osc/HSVectorOscillator.h"
 #include "vector_osc/WaveformManager.h"
 
+#if ENABLE_APPLET_VectorEG
+
 class VectorEG : public HemisphereApplet {
 public:
 
@@ -192,8 +194,11 @@ VectorEG VectorEG_instance[2];
 void VectorEG_Start(bool hemisphere) {VectorEG_instance[hemisphere].BaseStart(hemisphere);}
 void VectorEG_Controller(bool hemisphere, bool forwarding) {VectorEG_instance[hemisphere].BaseController(forwarding);}
 void VectorEG_View(bool hemisphere) {VectorEG_instance[hemisphere].BaseView();}
+uint32_t VectorEG_ViewHash(bool hemisphere) {return VectorEG_instance[hemisphere].ViewHash();}
 void VectorEG_OnButtonPress(bool hemisphere) {VectorEG_instance[hemisphere].OnButtonPress();}
 void VectorEG_OnEncoderMove(bool hemisphere, int direction) {VectorEG_instance[hemisphere].OnEncoderMove(direction);}
 void VectorEG_ToggleHelpScreen(bool hemisphere) {VectorEG_instance[hemisphere].HelpScreen();}
 uint32_t VectorEG_OnDataRequest(bool hemisphere) {return VectorEG_instance[hemisphere].OnDataRequest();}
 void VectorEG_OnDataReceive(bool hemisphere, uint32_t data) {VectorEG_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_VectorEG
@@ -21,6 +21,8 @@
 #include "vector_osc/HSVectorOscillator.h"
 #include "vector_osc/WaveformManager.h"
 
+#if ENABLE_APPLET_VectorLFO
+
 class VectorLFO : public HemisphereApplet {
 public:
 
@@ -221,8 +223,11 @@ VectorLFO VectorLFO_instance[2];
 void VectorLFO_Start(bool hemisphere) {VectorLFO_instance[hemisphere].BaseStart(hemisphere);}
 void VectorLFO_Controller(bool hemisphere, bool forwarding) {VectorLFO_instance[hemisphere].BaseController(forwarding);}
 void VectorLFO_View(bool hemisphere) {VectorLFO_instance[hemisphere].BaseView();}
+uint32_t VectorLFO_ViewHash(bool hemisphere) {return VectorLFO_instance[hemisphere].ViewHash();}
 void VectorLFO_OnButtonPress(bool hemisphere) {VectorLFO_instance[hemisphere].OnButtonPress();}
 void VectorLFO_OnEncoderMove(bool hemisphere, int direction) {VectorLFO_instance[hemisphere].OnEncoderMove(direction);}
 void VectorLFO_ToggleHelpScreen(bool hemisphere) {VectorLFO_instance[hemisphere].HelpScreen();}
 uint32_t VectorLFO_OnDataRequest(bool hemisphere) {return VectorLFO_instance[hemisphere].OnDataRequest();}
 void VectorLFO_OnDataReceive(bool hemisphere, uint32_t data) {VectorLFO_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_VectorLFO
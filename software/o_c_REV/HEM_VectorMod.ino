@@ -21,6 +21,8 @@
 #include "vector_osc/HSVectorOscillator.h"
 #include "vector_osc/WaveformManager.h"
 
+#if ENABLE_APPLET_VectorMod
+
 class VectorMod : public HemisphereApplet {
 public:
 
@@ -184,8 +186,11 @@ VectorMod VectorMod_instance[2];
 void VectorMod_Start(bool hemisphere) {VectorMod_instance[hemisphere].BaseStart(hemisphere);}
 void VectorMod_Controller(bool hemisphere, bool forwarding) {VectorMod_instance[hemisphere].BaseController(forwarding);}
 void VectorMod_View(bool hemisphere) {VectorMod_instance[hemisphere].BaseView();}
+uint32_t VectorMod_ViewHash(bool hemisphere) {return VectorMod_instance[hemisphere].ViewHash();}
 void VectorMod_OnButtonPress(bool hemisphere) {VectorMod_instance[hemisphere].OnButtonPress();}
 void VectorMod_OnEncoderMove(bool hemisphere, int direction) {VectorMod_instance[hemisphere].OnEncoderMove(direction);}
 void VectorMod_ToggleHelpScreen(bool hemisphere) {VectorMod_instance[hemisphere].HelpScreen();}
 uint32_t VectorMod_OnDataRequest(bool hemisphere) {return VectorMod_instance[hemisphere].OnDataRequest();}
 void VectorMod_OnDataReceive(bool hemisphere, uint32_t data) {VectorMod_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_VectorMod
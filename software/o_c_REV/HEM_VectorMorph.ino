@@ -21,6 +21,8 @@
 #include "vector_osc/HSVectorOscillator.h"
 #include "vector_osc/WaveformManager.h"
 
+#if ENABLE_APPLET_VectorMorph
+
 class VectorMorph : public HemisphereApplet {
 public:
 
@@ -185,8 +187,11 @@ VectorMorph VectorMorph_instance[2];
 void VectorMorph_Start(bool hemisphere) {VectorMorph_instance[hemisphere].BaseStart(hemisphere);}
 void VectorMorph_Controller(bool hemisphere, bool forwarding) {VectorMorph_instance[hemisphere].BaseController(forwarding);}
 void VectorMorph_View(bool hemisphere) {VectorMorph_instance[hemisphere].BaseView();}
+uint32_t VectorMorph_ViewHash(bool hemisphere) {return VectorMorph_instance[hemisphere].ViewHash();}
 void VectorMorph_OnButtonPress(bool hemisphere) {VectorMorph_instance[hemisphere].OnButtonPress();}
 void VectorMorph_OnEncoderMove(bool hemisphere, int direction) {VectorMorph_instance[hemisphere].OnEncoderMove(direction);}
 void VectorMorph_ToggleHelpScreen(bool hemisphere) {VectorMorph_instance[hemisphere].HelpScreen();}
 uint32_t VectorMorph_OnDataRequest(bool hemisphere) {return VectorMorph_instance[hemisphere].OnDataRequest();}
 void VectorMorph_OnDataReceive(bool hemisphere, uint32_t data) {VectorMorph_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_VectorMorph
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_Voltage
+
 #define VOLTAGE_INCREMENTS 128
 
 class Voltage : public HemisphereApplet {
@@ -55,6 +57,10 @@ public:
         DrawInterface();
     }
 
+    uint32_t ViewHash() {
+        return ViewHashOf(voltage[0], voltage[1], gate[0], gate[1], view[0], view[1], cursor, CursorBlink());
+    }
+
     void OnButtonPress() {
         if (++cursor > 3) cursor = 0;
         ResetCursor();
@@ -138,8 +144,11 @@ Voltage Voltage_instance[2];
 void Voltage_Start(bool hemisphere) {Voltage_instance[hemisphere].BaseStart(hemisphere);}
 void Voltage_Controller(bool hemisphere, bool forwarding) {Voltage_instance[hemisphere].BaseController(forwarding);}
 void Voltage_View(bool hemisphere) {Voltage_instance[hemisphere].BaseView();}
+uint32_t Voltage_ViewHash(bool hemisphere) {return Voltage_instance[hemisphere].ViewHash();}
 void Voltage_OnButtonPress(bool hemisphere) {Voltage_instance[hemisphere].OnButtonPress();}
 void Voltage_OnEncoderMove(bool hemisphere, int direction) {Voltage_instance[hemisphere].OnEncoderMove(direction);}
 void Voltage_ToggleHelpScreen(bool hemisphere) {Voltage_instance[hemisphere].HelpScreen();}
 uint32_t Voltage_OnDataRequest(bool hemisphere) {return Voltage_instance[hemisphere].OnDataRequest();}
 void Voltage_OnDataReceive(bool hemisphere, uint32_t data) {Voltage_instance[hemisphere].OnDataReceive(data);}
+
+#endif // ENABLE_APPLET_Voltage
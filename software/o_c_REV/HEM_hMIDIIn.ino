@@ -46,6 +46,9 @@ struct MIDILogEntry {
     int data2;
 };
 
+// The definitions above are shared with hMIDIOut
+#if ENABLE_APPLET_hMIDIIn
+
 class hMIDIIn : public HemisphereApplet {
 public:
 
@@ -288,13 +291,13 @@ private:
     void log_entry(int y, int index) {
         if (log[index].message == HEM_MIDI_NOTE_ON) {
             gfxBitmap(1, y, 8, NOTE_ICON);
-            gfxPrint(10, y, midi_note_numbers[log[index].data1]);
+            gfxPrintNote(10, y, log[index].data1);
             gfxPrint(40, y, log[index].data2);
         }
 
         if (log[index].message == HEM_MIDI_NOTE_OFF) {
             gfxPrint(1, y, "-");
-            gfxPrint(10, y, midi_note_numbers[log[index].data1]);
+            gfxPrintNote(10, y, log[index].data1);
         }
 
         if (log[index].message == HEM_MIDI_CC) {
@@ -337,6 +340,10 @@ void hMIDIIn_View(bool hemisphere) {
     hMIDIIn_instance[hemisphere].BaseView();
 }
 
+uint32_t hMIDIIn_ViewHash(bool hemisphere) {
+    return hMIDIIn_instance[hemisphere].ViewHash();
+}
+
 void hMIDIIn_OnButtonPress(bool hemisphere) {
     hMIDIIn_instance[hemisphere].OnButtonPress();
 }
@@ -356,3 +363,5 @@ uint32_t hMIDIIn_OnDataRequest(bool hemisphere) {
 void hMIDIIn_OnDataReceive(bool hemisphere, uint32_t data) {
     hMIDIIn_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_hMIDIIn
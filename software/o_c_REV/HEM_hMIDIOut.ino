@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#if ENABLE_APPLET_hMIDIOut
+
 // See https://www.pjrc.com/teensy/td_midi.html
 
 // The functions available for each output
@@ -236,7 +238,7 @@ private:
         // Last note log
         if (last_velocity) {
             gfxBitmap(1, 56, 8, NOTE_ICON);
-            gfxPrint(10, 56, midi_note_numbers[last_note]);
+            gfxPrintNote(10, 56, last_note);
             gfxPrint(40, 56, last_velocity);
         }
         gfxInvert(0, 55, 63, 9);
@@ -254,13 +256,13 @@ private:
     void log_entry(int y, int index) {
         if (log[index].message == HEM_MIDI_NOTE_ON) {
             gfxBitmap(1, y, 8, NOTE_ICON);
-            gfxPrint(10, y, midi_note_numbers[log[index].data1]);
+            gfxPrintNote(10, y, log[index].data1);
             gfxPrint(40, y, log[index].data2);
         }
 
         if (log[index].message == HEM_MIDI_NOTE_OFF) {
             gfxPrint(1, y, "-");
-            gfxPrint(10, y, midi_note_numbers[log[index].data1]);
+            gfxPrintNote(10, y, log[index].data1);
         }
 
         if (log[index].message == HEM_MIDI_CC) {
@@ -304,6 +306,10 @@ void hMIDIOut_View(bool hemisphere) {
     hMIDIOut_instance[hemisphere].BaseView();
 }
 
+uint32_t hMIDIOut_ViewHash(bool hemisphere) {
+    return hMIDIOut_instance[hemisphere].ViewHash();
+}
+
 void hMIDIOut_OnButtonPress(bool hemisphere) {
     hMIDIOut_instance[hemisphere].OnButtonPress();
 }
@@ -323,3 +329,5 @@ uint32_t hMIDIOut_OnDataRequest(bool hemisphere) {
 void hMIDIOut_OnDataReceive(bool hemisphere, uint32_t data) {
     hMIDIOut_instance[hemisphere].OnDataReceive(data);
 }
+
+#endif // ENABLE_APPLET_hMIDIOut
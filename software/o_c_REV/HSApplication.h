@@ -40,6 +40,8 @@ typedef int32_t simfloat;
 #define HSAPPLICATION_5V 7680
 #define HSAPPLICATION_3V 4608
 #define HSAPPLICATION_CHANGE_THRESHOLD 32
+#define HSAPPLICATION_CHANGE_LEVEL ADC_CHANGE_DEFAULT // Same threshold, from OC::ADC
+#define HSAPPLICATION_ADC_LAG 2 // Settling time after clock before a conversion counts
 
 #ifdef BUCHLA_4U
 #define PULSE_VOLTAGE 8
@@ -59,10 +61,7 @@ public:
         {
             // Set ADC input values
             inputs[ch] = OC::ADC::raw_pitch_value((ADC_CHANNEL)ch);
-            if (abs(inputs[ch] - last_cv[ch]) > HSAPPLICATION_CHANGE_THRESHOLD) {
-                changed_cv[ch] = 1;
-                last_cv[ch] = inputs[ch];
-            } else changed_cv[ch] = 0;
+            changed_cv[ch] = OC::ADC::changed((ADC_CHANNEL)ch, HSAPPLICATION_CHANGE_LEVEL);
 
             if (clock_countdown[ch] > 0) {
                 if (--clock_countdown[ch] == 0) Out(ch, 0);
@@ -80,7 +79,7 @@ public:
         for (uint8_t ch = 0; ch < 4; ch++)
         {
             clock_countdown[ch]  = 0;
-            adc_lag_countdown[ch] = 0;
+            adc_lag[ch].Init();
         }
         cursor_countdown = HSAPPLICATION_CURSOR_TICKS;
 
@@ -88,10 +87,32 @@ public:
     }
 
     void BaseView() {
+        uint32_t key = ChromeKey();
+        if (key) {
+            weegfx::Layer &layer = chrome_layer();
+            if (!layer.valid(this, key)) {
+                graphics.BeginLayer(layer, this, key);
+                DrawChrome();
+                graphics.EndLayer();
+            }
+            graphics.drawLayer(layer);
+        }
         View();
         last_view_tick = OC::CORE::ticks;
     }
 
+    // Static parts of the screen (headers, frames, labels) can be drawn by DrawChrome()
+    // instead of View(). They're drawn once into a layer that is copied into each frame,
+    // and redrawn when ChromeKey() changes, e.g. with the mode. 0 = no chrome.
+    virtual uint32_t ChromeKey() {return 0;}
+    virtual void DrawChrome() {}
+
+    // Only one app is on screen, so they share a single layer
+    static weegfx::Layer &chrome_layer() {
+        static weegfx::Layer layer;
+        return layer;
+    }
+
     int Proportion(int numerator, int denominator, int max_value) {
         simfloat proportion = int2simfloat((int32_t)numerator) / (int32_t)denominator;
         int scaled = simfloat2int(proportion * max_value);
@@ -164,9 +185,11 @@ public:
      *     int cv = In(ch);
      *     // etc...
      * }
+     *
+     * EndOfADCLag is true once, for the first value of the input converted after the clock.
      */
-    void StartADCLag(int ch) {adc_lag_countdown[ch] = 96;}
-    bool EndOfADCLag(int ch) {return (--adc_lag_countdown[ch] == 0);}
+    void StartADCLag(int ch) {adc_lag[ch].Start(OC::CORE::ticks + HSAPPLICATION_ADC_LAG);}
+    bool EndOfADCLag(int ch) {return adc_lag[ch].Ready(OC::ADC::conversion_tick((ADC_CHANNEL)ch));}
 
     //////////////// Hemisphere-like graphics methods for easy porting
     ////////////////////////////////////////////////////////////////////////////////
@@ -272,13 +295,12 @@ protected:
 
 private:
     int clock_countdown[4]; // For clock output timing
-    int adc_lag_countdown[4]; // Lag countdown for each input channel
+    util::ADCSampleWait adc_lag[4]; // Lag for each input channel
     int cursor_countdown; // Timer for cursor blinkin'
     uint32_t last_view_tick; // Time since the last view, for activating screen blanking
     int inputs[4]; // Last ADC values
     int outputs[4]; // Last DAC values; inputs[] and outputs[] are used to allow access to values in Views
-    bool changed_cv[4]; // Has the input changed by more than 1/8 semitone since the last read?
-    int last_cv[4]; // For change detection
+    bool changed_cv[4]; // Has the input changed by more than 1/4 semitone since the last read?
     uint32_t last_clock[4]; // Tick number of the last clock observed by the child class
     uint32_t cycle_ticks[4]; // Number of ticks between last two clocks
 };
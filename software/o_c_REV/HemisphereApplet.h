@@ -27,6 +27,9 @@
 
 #include "HSicons.h"
 #include "HSClockManager.h"
+#include "util/util_simd2.h"
+
+namespace simd2 = util::simd2;
 
 #define LEFT_HEMISPHERE 0
 #define RIGHT_HEMISPHERE 1
@@ -40,8 +43,9 @@
 #define HEMISPHERE_3V_CV 4608
 #define HEMISPHERE_CLOCK_TICKS 100
 #define HEMISPHERE_CURSOR_TICKS 12000
-#define HEMISPHERE_ADC_LAG 33
+#define HEMISPHERE_ADC_LAG 2 // Settling time after clock before a conversion counts
 #define HEMISPHERE_CHANGE_THRESHOLD 32
+#define HEMISPHERE_CHANGE_LEVEL ADC_CHANGE_DEFAULT // Same threshold, from OC::ADC
 
 #ifdef BUCHLA_4U
 #define PULSE_VOLTAGE 8
@@ -91,22 +95,13 @@ public:
             clock_countdown[ch]  = 0;
             inputs[ch] = 0;
             outputs[ch] = 0;
-            adc_lag_countdown[ch] = 0;
+            adc_lag[ch].Init();
+            // The previous applet's output ramps would keep running otherwise
+            OC::DAC::cancel_ramp((DAC_CHANNEL)(ch + io_offset));
         }
         help_active = 0;
         cursor_countdown = HEMISPHERE_CURSOR_TICKS;
 
-        // Shutdown FTM capture on Digital 4, used by Tuner
-#ifdef FLIP_180
-        if (hemisphere == 0)
-#else
-        if (hemisphere == 1)
-#endif
-        {
-            FreqMeasure.end();
-            OC::DigitalInputs::reInit();
-        }
-
         // Maintain previous app state by skipping Start
         if (!applet_started) {
             applet_started = true;
@@ -121,10 +116,7 @@ public:
             // Set CV inputs
             ADC_CHANNEL channel = (ADC_CHANNEL)(ch + io_offset);
             inputs[ch] = OC::ADC::raw_pitch_value(channel);
-            if (abs(inputs[ch] - last_cv[ch]) > HEMISPHERE_CHANGE_THRESHOLD) {
-                changed_cv[ch] = 1;
-                last_cv[ch] = inputs[ch];
-            } else changed_cv[ch] = 0;
+            changed_cv[ch] = OC::ADC::changed(channel, HEMISPHERE_CHANGE_LEVEL);
 
             // Handle clock timing
             if (clock_countdown[ch] > 0) {
@@ -145,6 +137,23 @@ public:
         last_view_tick = OC::CORE::ticks;
     }
 
+    /* Hash of the state that View() depends on. HemisphereManager only redraws the hemisphere
+     * when this changes, so an override must include everything View() reads, including
+     * CursorBlink() if the cursor is used. See ViewHashOf(). The default changes with every
+     * tick, so the applet is redrawn every frame. */
+    virtual uint32_t ViewHash() {
+        return OC::CORE::ticks;
+    }
+
+    static uint32_t ViewHashOf() {
+        return 0x811c9dc5;
+    }
+
+    template <typename T, typename... Rest>
+    static uint32_t ViewHashOf(T value, Rest... rest) {
+        return (ViewHashOf(rest...) ^ static_cast<uint32_t>(value)) * 0x01000193;
+    }
+
     // Screensavers are deprecated in favor of screen blanking, but the BaseScreensaverView() remains
     // to avoid breaking applets based on the old boilerplate
     void BaseScreensaverView() {}
@@ -202,7 +211,7 @@ public:
     }
 
     void gfxPrint(int x_adv, int num) { // Print number with character padding
-        for (int c = 0; c < (x_adv / 6); c++) gfxPrint(" ");
+        graphics.movePrintPos((x_adv / 6) * 6, 0);
         gfxPrint(num);
     }
 
@@ -216,17 +225,14 @@ public:
 
     /* Convert CV value to voltage level and print  to two decimal places */
     void gfxPrintVoltage(int cv) {
-        int v = (cv * 100) / (12 << 7);
-        bool neg = v < 0 ? 1 : 0;
-        if (v < 0) v = -v;
-        int wv = v / 100; // whole volts
-        int dv = v - (wv * 100); // decimal
-        gfxPrint(neg ? "-" : "+");
-        gfxPrint(wv);
-        gfxPrint(".");
-        if (dv < 10) gfxPrint("0");
-        gfxPrint(dv);
-        gfxPrint("V");
+        graphics.print_fixed(cv, 12 << 7, 2, true);
+        graphics.print('V');
+    }
+
+    /* Print MIDI note number as note name and octave, e.g. C#4 */
+    void gfxPrintNote(int x, int y, int note) {
+        graphics.setPrintPos(x + gfx_offset, y);
+        graphics.print_note(note);
     }
 
     void gfxPixel(int x, int y) {
@@ -317,6 +323,15 @@ public:
         outputs[ch] = value + (octave * (12 << 7));
     }
 
+    // Slew-limited output: the DAC moves towards value at rate (simfloat per
+    // tick) on its own, so this only needs to be called when the target or
+    // rate changes. ViewOut() follows the current position.
+    void SlewOut(int ch, int value, simfloat rate) {
+        DAC_CHANNEL channel = (DAC_CHANNEL)(ch + io_offset);
+        OC::DAC::set_pitch_ramp_rate(channel, value, rate);
+        outputs[ch] = OC::DAC::ramp_pitch(channel);
+    }
+
     /*
      * Has the specified Digital input been clocked this cycle?
      *
@@ -324,24 +339,37 @@ public:
      * not be used.
      */
     bool Clock(int ch, bool physical = 0) {
-        bool clocked = 0;
-        if (hemisphere == 0) {
-            if (ch == 0) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_1>();
-            if (ch == 1) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_2>();
-        } else if (hemisphere == 1) {
-            if (ch == 0) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_3>();
-            if (ch == 1) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_4>();
-        }
+        int input = io_offset + ch; // Digital input the clock came from, -1 if none
+        bool clocked = OC::DigitalInputs::clocked(static_cast<OC::DigitalInput>(input));
 
         if (ch == 0 && !physical) {
             ClockManager *clock_m = clock_m->get();
-            if (clock_m->IsRunning()) clocked = clock_m->Tock();
-            else if (master_clock_bus) clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_1>();
+            if (clock_m->IsRunning()) {
+                clocked = clock_m->Tock();
+                input = -1;
+            } else if (master_clock_bus) {
+                input = OC::DIGITAL_INPUT_1;
+                clocked = OC::DigitalInputs::clocked<OC::DIGITAL_INPUT_1>();
+            }
         }
 
+        clock_count[ch] = 0;
         if (clocked) {
         		cycle_ticks[ch] = OC::CORE::ticks - last_clock[ch];
         		last_clock[ch] = OC::CORE::ticks;
+
+            // Use the edge counts and timestamps where available
+            uint32_t period = 0;
+            clock_count[ch] = 1;
+            clock_age[ch] = 0;
+            if (input > -1) {
+                OC::DigitalInput digital_input = static_cast<OC::DigitalInput>(input);
+                clock_count[ch] = OC::DigitalInputs::rising_edges(digital_input);
+                const OC::DigitalInputs::ClockPLL &pll = OC::DigitalInputs::clock_pll(digital_input);
+                period = pll.locked() ? pll.period() : OC::DigitalInputs::edge_period(digital_input);
+                clock_age[ch] = OC::DigitalInputs::edge_age(digital_input);
+            }
+            cycle_precise[ch] = period ? period : cycle_ticks[ch] << OC::DigitalInputs::kEdgeFracBits;
         }
         return clocked;
     }
@@ -372,8 +400,31 @@ public:
     int ViewIn(int ch) {return inputs[ch];}
     int ViewOut(int ch) {return outputs[ch];}
     int ClockCycleTicks(int ch) {return cycle_ticks[ch];}
+
+    // Number of clocks in the last Clock() call; fast bursts may have more than
+    // one edge per tick.
+    int ClockCount(int ch) {return clock_count[ch];}
+
+    // Sub-tick clock timing, in ticks with OC::DigitalInputs::kEdgeFracBits
+    // fractional bits: the period between the last two clocks (smoothed once
+    // the input's period estimator is locked), and how long before the current
+    // tick the last clock's edge occurred. Clocks from the clock manager have
+    // no edge and are tick-aligned.
+    uint32_t ClockCyclePrecise(int ch) {return cycle_precise[ch];}
+    uint32_t ClockEdgeAge(int ch) {return clock_age[ch];}
+
+    // Clock period rounded to ticks, for timing that doesn't need sub-ticks
+    uint32_t ClockPeriodTicks(int ch) {
+        return (cycle_precise[ch] + (1 << (OC::DigitalInputs::kEdgeFracBits - 1))) >> OC::DigitalInputs::kEdgeFracBits;
+    }
     bool Changed(int ch) {return changed_cv[ch];}
 
+    // Input changed by more than the given threshold this tick, for cheap
+    // early-outs in Controller(); In() doesn't change otherwise.
+    bool Changed(int ch, ADC_CHANGE_THRESHOLD level) {
+        return OC::ADC::changed((ADC_CHANNEL)(ch + io_offset), level);
+    }
+
 protected:
     bool hemisphere; // Which hemisphere (0, 1) this applet uses
     const char* help[4];
@@ -441,13 +492,18 @@ protected:
      *     int cv = In(ch);
      *     // etc...
      * }
+     *
+     * EndOfADCLag is true once, as soon as both inputs have a value that was converted after the
+     * clock (plus HEMISPHERE_ADC_LAG ticks of settling time).
      */
     void StartADCLag(int ch = 0) {
-        adc_lag_countdown[ch] = HEMISPHERE_ADC_LAG;
+        adc_lag[ch].Start(OC::CORE::ticks + HEMISPHERE_ADC_LAG);
     }
 
     bool EndOfADCLag(int ch = 0) {
-        return (--adc_lag_countdown[ch] == 0);
+        uint32_t tick0 = OC::ADC::conversion_tick((ADC_CHANNEL)io_offset);
+        uint32_t tick1 = OC::ADC::conversion_tick((ADC_CHANNEL)(io_offset + 1));
+        return adc_lag[ch].Ready((int32_t)(tick0 - tick1) < 0 ? tick0 : tick1);
     }
 
     /* Master Clock Forwarding is activated. This is updated with each ISR cycle by the Hemisphere Manager */
@@ -460,13 +516,15 @@ private:
     int outputs[2];
     uint32_t last_clock[2]; // Tick number of the last clock observed by the child class
     uint32_t cycle_ticks[2]; // Number of ticks between last two clocks
+    int clock_count[2]; // Number of clock edges seen by the last Clock()
+    uint32_t cycle_precise[2]; // Time between last two clocks, with sub-tick precision
+    uint32_t clock_age[2]; // Time between last clock edge and the tick it was seen in
     int clock_countdown[2];
     int cursor_countdown;
-    int adc_lag_countdown[2]; // Time between a clock event and an ADC read event
+    util::ADCSampleWait adc_lag[2]; // Wait between a clock event and an ADC read event
     bool master_clock_bus; // Clock forwarding was on during the last ISR cycle
     bool applet_started; // Allow the app to maintain state during switching
     int last_view_tick; // Tick number of the most recent view
     int help_active;
-    bool changed_cv[2]; // Has the input changed by more than 1/8 semitone since the last read?
-    int last_cv[2]; // For change detection
+    bool changed_cv[2]; // Has the input changed by more than 1/4 semitone since the last read?
 };
@@ -1,7 +1,11 @@
 #include "OC_ADC.h"
 #include "OC_gpio.h"
+#include "OC_core.h"
 
 #include <algorithm>
+#ifdef ADC_DMA_SCAN
+#include <DMAChannel.h>
+#endif
 
 namespace OC {
 
@@ -19,13 +23,55 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   static const int PIN = CV4;
 };
 
+static const uint8_t scan_pins[ADC_CHANNEL_LAST] = {
+  ChannelDesc<ADC_CHANNEL_1>::PIN,
+  ChannelDesc<ADC_CHANNEL_2>::PIN,
+  ChannelDesc<ADC_CHANNEL_3>::PIN,
+  ChannelDesc<ADC_CHANNEL_4>::PIN,
+};
+
 /*static*/ ::ADC ADC::adc_;
 /*static*/ size_t ADC::scan_channel_;
 /*static*/ ADC::CalibrationData *ADC::calibration_data_;
 /*static*/ uint32_t ADC::raw_[ADC_CHANNEL_LAST];
 /*static*/ uint32_t ADC::smoothed_[ADC_CHANNEL_LAST];
+/*static*/ ADC::DeepHistory ADC::deep_history_[ADC_CHANNEL_LAST];
+/*static*/ util::ZeroCrossingDetector ADC::zero_crossings_[ADC_CHANNEL_LAST];
+/*static*/ ADC::FrequencyCounter ADC::frequency_counters_[ADC_CHANNEL_LAST];
+/*static*/ ADC::Values ADC::values_[ADC_CHANNEL_LAST];
+/*static*/ const int32_t ADC::kChangeThresholds[ADC_CHANGE_THRESHOLD_LAST] = { 8, 32, 128 };
+/*static*/ util::ADCChangeDetector<ADC_CHANGE_THRESHOLD_LAST> ADC::change_detectors_[ADC_CHANNEL_LAST];
+/*static*/ uint32_t ADC::changed_[ADC_CHANGE_THRESHOLD_LAST];
+/*static*/ uint32_t ADC::conversion_ticks_[ADC_CHANNEL_LAST];
+/*static*/ ADC::FilterFn ADC::filters_[ADC_CHANNEL_LAST];
+/*static*/ util::ADCFilterState ADC::filter_states_[ADC_CHANNEL_LAST];
+/*static*/ ADC_FILTER_PROFILE ADC::filter_profiles_[ADC_CHANNEL_LAST];
+
+// Profiles are selected by swapping the function, so there's no branching on
+// the profile in the ISR
+static const ADC::FilterFn filter_fns[ADC_FILTER_PROFILE_LAST] = {
+  ADC::FilterProfiles::Default::Process,
+  ADC::FilterProfiles::None::Process,
+  ADC::FilterProfiles::Smooth::Process,
+  ADC::FilterProfiles::Adaptive::Process,
+};
+#ifdef ADC_DMA_SCAN
+/*static*/ ADC::ScanRing ADC::scan_ring_;
+/*static*/ uint32_t ADC::mux_sequence_[ADC_CHANNEL_LAST];
+
+// Results are transferred from ADC0_RA into the ring on conversion complete;
+// each result transfer triggers the mux transfer that writes the next channel
+// to ADC0_SC1A, which starts the next conversion.
+static DMAChannel scan_result_dma;
+static DMAChannel scan_mux_dma;
+#else
+/*static*/ ADC::ScanSchedule ADC::scan_schedule_;
+#endif
 #ifdef ENABLE_ADC_DEBUG
 /*static*/ volatile uint32_t ADC::busy_waits_;
+#ifdef ADC_DMA_SCAN
+/*static*/ volatile uint32_t ADC::stale_scans_;
+#endif
 #endif
 
 /*static*/ void ADC::Init(CalibrationData *calibration_data) {
@@ -42,27 +88,100 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   adc_.setConversionSpeed(kAdcConversionSpeed);
   adc_.setSamplingSpeed(kAdcSamplingSpeed);
   adc_.setAveraging(kAdcScanAverages);
-  adc_.disableDMA();
   adc_.disableInterrupts();
   adc_.disableCompare();
 
+#ifdef ADC_DMA_SCAN
   scan_channel_ = ADC_CHANNEL_1;
-  adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN);
+  InitDMAScan();
+#else
+  adc_.disableDMA();
+  scan_schedule_.Init();
+  scan_channel_ = scan_schedule_.Next();
+  adc_.startSingleRead(scan_pins[scan_channel_]);
+#endif
 
   calibration_data_ = calibration_data;
   std::fill(raw_, raw_ + ADC_CHANNEL_LAST, 0);
   std::fill(smoothed_, smoothed_ + ADC_CHANNEL_LAST, 0);
+  for (auto &history : deep_history_) {
+    history.Init(0);
+    history.set_decimation(kDefaultHistoryDecimation);
+  }
+  for (int i = ADC_CHANNEL_1; i < ADC_CHANNEL_LAST; ++i) {
+    set_filter_profile(static_cast<ADC_CHANNEL>(i), ADC_FILTER_DEFAULT);
+    values_[i] = { 0, 0, 0 };
+    change_detectors_[i].Init(0);
+    zero_crossings_[i].Init(kZeroCrossingHysteresis);
+    frequency_counters_[i].Init(kFrequencyGateTime, kFrequencyTimeout);
+  }
+  std::fill(changed_, changed_ + ADC_CHANGE_THRESHOLD_LAST, 0);
+  std::fill(conversion_ticks_, conversion_ticks_ + ADC_CHANNEL_LAST, 0);
 #ifdef ENABLE_ADC_DEBUG
   busy_waits_ = 0;
+#ifdef ADC_DMA_SCAN
+  stale_scans_ = 0;
+#endif
 #endif
 }
 
+#ifdef ADC_DMA_SCAN
+/*static*/ void ADC::InitDMAScan() {
+  // The mux sequence only contains the SC1A channel, so all pins need to be on
+  // the same MUXSEL (they are: A3-A6 are all "b"), which is set when starting
+  // the first conversion below.
+  const uint8_t channel_mux[ADC_CHANNEL_LAST] = {
+    (uint8_t)(::ADC::channel2sc1aADC0[ChannelDesc<ADC_CHANNEL_1>::PIN] & ADC_SC1A_CHANNELS),
+    (uint8_t)(::ADC::channel2sc1aADC0[ChannelDesc<ADC_CHANNEL_2>::PIN] & ADC_SC1A_CHANNELS),
+    (uint8_t)(::ADC::channel2sc1aADC0[ChannelDesc<ADC_CHANNEL_3>::PIN] & ADC_SC1A_CHANNELS),
+    (uint8_t)(::ADC::channel2sc1aADC0[ChannelDesc<ADC_CHANNEL_4>::PIN] & ADC_SC1A_CHANNELS),
+  };
+  ScanRing::InitMuxSequence(channel_mux, mux_sequence_);
+  scan_ring_.Init();
+
+  scan_result_dma.source((volatile uint16_t&)ADC0_RA);
+  scan_result_dma.destinationBuffer(scan_ring_.buffer(), ScanRing::kSize * sizeof(uint16_t));
+  scan_result_dma.triggerAtHardwareEvent(DMAMUX_SOURCE_ADC0);
+
+  scan_mux_dma.sourceBuffer(mux_sequence_, sizeof(mux_sequence_));
+  scan_mux_dma.destination(ADC0_SC1A);
+  scan_mux_dma.triggerAtTransfersOf(scan_result_dma);
+  scan_mux_dma.triggerAtCompletionOf(scan_result_dma);
+
+  scan_mux_dma.enable();
+  scan_result_dma.enable();
+  adc_.enableDMA(ADC_0);
+  adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN, ADC_0);
+}
+#endif
+
 // As I understand it, only CV4 can be muxed to ADC1, so it's not possible to
 // use ADC::startSynchronizedSingleRead, which would allow reading two channels
 // simultaneously
 
 /*static*/ void FASTRUN ADC::Scan() {
 
+  std::fill(changed_, changed_ + ADC_CHANGE_THRESHOLD_LAST, 0);
+
+#ifdef ADC_DMA_SCAN
+  const volatile uint16_t *write_ptr = (const volatile uint16_t *)scan_result_dma.TCD->DADDR;
+  uint16_t values[ADC_CHANNEL_LAST];
+  if (!scan_ring_.ReadLatest(write_ptr - scan_ring_.buffer(), values)) {
+#ifdef ENABLE_ADC_DEBUG
+    ++stale_scans_;
+#endif
+    return;
+  }
+  // The block completed after the last Scan and takes less than an ISR period
+  // to convert, so it was started after the Scan before that (ticks is
+  // incremented after Scan)
+  const uint32_t conversion_tick = CORE::ticks - 1;
+  update<ADC_CHANNEL_1>(values[ADC_CHANNEL_1], conversion_tick);
+  update<ADC_CHANNEL_2>(values[ADC_CHANNEL_2], conversion_tick);
+  update<ADC_CHANNEL_3>(values[ADC_CHANNEL_3], conversion_tick);
+  update<ADC_CHANNEL_4>(values[ADC_CHANNEL_4], conversion_tick);
+#else
+
 #ifdef ENABLE_ADC_DEBUG
   if (!adc_.isComplete(ADC_0)) {
     ++busy_waits_;
@@ -70,34 +189,73 @@ template <> struct ChannelDesc<ADC_CHANNEL_4> {
   }
 #endif
   const uint16_t value = adc_.readSingle(ADC_0);
+  // Conversion was started in the last Scan, i.e. in the ISR that had tick ==
+  // ticks (ticks is incremented after Scan)
+  const uint32_t conversion_tick = CORE::ticks;
+
+  const size_t channel = scan_channel_;
+  const size_t next_channel = scan_schedule_.Next();
+  adc_.startSingleRead(scan_pins[next_channel], ADC_0);
 
-  size_t channel = scan_channel_;
   switch (channel) {
-    case ADC_CHANNEL_1:
-      adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_2>::PIN, ADC_0);
-      update<ADC_CHANNEL_1>(value);
-      ++channel; 
-      break;
-
-    case ADC_CHANNEL_2:
-      adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_3>::PIN, ADC_0);
-      update<ADC_CHANNEL_2>(value);
-      ++channel; 
-      break;
-
-    case ADC_CHANNEL_3:
-      adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_4>::PIN, ADC_0);
-      update<ADC_CHANNEL_3>(value);
-      ++channel; 
-      break;
-
-    case ADC_CHANNEL_4:
-      adc_.startSingleRead(ChannelDesc<ADC_CHANNEL_1>::PIN, ADC_0);
-      update<ADC_CHANNEL_4>(value);
-      channel = ADC_CHANNEL_1;
-      break;
+    case ADC_CHANNEL_1: update<ADC_CHANNEL_1>(value, conversion_tick); break;
+    case ADC_CHANNEL_2: update<ADC_CHANNEL_2>(value, conversion_tick); break;
+    case ADC_CHANNEL_3: update<ADC_CHANNEL_3>(value, conversion_tick); break;
+    case ADC_CHANNEL_4: update<ADC_CHANNEL_4>(value, conversion_tick); break;
   }
-  scan_channel_ = channel;
+  scan_channel_ = next_channel;
+#endif
+}
+
+/*static*/ void ADC::set_filter_profile(ADC_CHANNEL channel, ADC_FILTER_PROFILE profile) {
+  if (profile >= ADC_FILTER_PROFILE_LAST)
+    profile = ADC_FILTER_DEFAULT;
+
+  __disable_irq();
+  filter_states_[channel].Reset(smoothed_[channel]);
+  filters_[channel] = filter_fns[profile];
+  filter_profiles_[channel] = profile;
+  __enable_irq();
+}
+
+/*static*/ void ADC::set_scan_weights(const uint8_t *weights) {
+#ifndef ADC_DMA_SCAN
+  ScanSchedule schedule;
+  if (weights)
+    schedule.Build(weights);
+  else
+    schedule.Init();
+
+  // The channel that is currently converting stays valid, the new schedule
+  // just starts from the beginning
+  __disable_irq();
+  scan_schedule_ = schedule;
+  __enable_irq();
+#else
+  (void)weights;
+#endif
+}
+
+/*static*/ uint32_t ADC::scan_rate(ADC_CHANNEL channel) {
+#ifdef ADC_DMA_SCAN
+  (void)channel;
+  return OC_CORE_ISR_FREQ;
+#else
+  return OC_CORE_ISR_FREQ * scan_schedule_.slot_count(channel) / kAdcScanSlots;
+#endif
+}
+
+/*static*/ void ADC::restore_filter_profiles(uint8_t profiles) {
+  for (int i = ADC_CHANNEL_1; i < ADC_CHANNEL_LAST; ++i)
+    set_filter_profile(static_cast<ADC_CHANNEL>(i), static_cast<ADC_FILTER_PROFILE>((profiles >> (i * 2)) & 0x3));
+}
+
+/*static*/ uint8_t ADC::store_filter_profiles() {
+  static_assert(ADC_FILTER_PROFILE_LAST <= 4, "Filter profiles need more than 2 bits");
+  uint8_t profiles = 0;
+  for (int i = ADC_CHANNEL_1; i < ADC_CHANNEL_LAST; ++i)
+    profiles |= filter_profiles_[i] << (i * 2);
+  return profiles;
 }
 
 /*static*/ void ADC::CalibratePitch(int32_t c2, int32_t c4) {
@@ -4,6 +4,11 @@
 #include <Arduino.h>
 #include "src/drivers/ADC/OC_util_ADC.h"
 #include "OC_config.h"
+#include "OC_options.h"
+#include "util/util_history_ring.h"
+#include "util/util_adc_scan.h"
+#include "util/util_adc_filter.h"
+#include "util/util_frequency_counter.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -18,25 +23,78 @@ enum ADC_CHANNEL {
   ADC_CHANNEL_LAST,
 };
 
+// Thresholds for change detection, in pitch units (128 per semitone)
+enum ADC_CHANGE_THRESHOLD {
+  ADC_CHANGE_FINE,    // 1/16 semitone
+  ADC_CHANGE_DEFAULT, // 1/4 semitone
+  ADC_CHANGE_COARSE,  // 1 semitone
+  ADC_CHANGE_THRESHOLD_LAST
+};
+
+enum ADC_FILTER_PROFILE {
+  ADC_FILTER_DEFAULT,
+  ADC_FILTER_NONE,
+  ADC_FILTER_SMOOTH,
+  ADC_FILTER_ADAPTIVE,
+  ADC_FILTER_PROFILE_LAST
+};
+
 namespace OC {
 
 class ADC {
 public:
 
   static constexpr uint8_t kAdcResolution = 12;
-  static constexpr uint32_t kAdcSmoothing = 4;
   static constexpr uint32_t kAdcSmoothBits = 8; // fractional bits for smoothing
   static constexpr uint16_t kDefaultPitchCVScale = SEMITONES << 7;
 
-  // These values should be tweaked so startSingleRead/readSingle run in main ISR update time
   // 16 bit has best-case 13 bits useable, but we only want 12 so we discard 4 anyway
   static constexpr uint8_t kAdcScanResolution = 16;
-  static constexpr uint8_t kAdcScanAverages = 16;
   static constexpr uint8_t kAdcSamplingSpeed = ADC_HIGH_SPEED_16BITS;
   static constexpr uint8_t kAdcConversionSpeed = ADC_HIGH_SPEED;
 
+#ifdef ADC_DMA_SCAN
+  // All channels are converted continuously and updated every ISR, so fewer
+  // averages (one block of conversions should take about one ISR period) and
+  // smoothing give the same noise level as the single read at twice the rate.
+  static constexpr uint8_t kAdcScanAverages = 8;
+  static constexpr uint32_t kAdcSmoothShift = 3;
+  static constexpr size_t kAdcScanBlocks = 4;
+#else
+  // Round-robin scan schedule, slots are distributed by channel weight
+  static constexpr size_t kAdcScanSlots = 16;
+  // These values should be tweaked so startSingleRead/readSingle run in main ISR update time
+  static constexpr uint8_t kAdcScanAverages = 16;
+  static constexpr uint32_t kAdcSmoothShift = 2;
+#endif
+
   static constexpr uint32_t kAdcValueShift = kAdcSmoothBits;
 
+  typedef util::ADCScanValue<kAdcScanResolution, kAdcResolution, kAdcSmoothBits> ScanValue;
+
+  // The filter for each channel is selected from these profiles, the default
+  // is the original smoothing with kAdcSmoothShift.
+  typedef util::ADCFilterProfiles<kAdcSmoothBits, kAdcSmoothShift> FilterProfiles;
+  typedef uint32_t (*FilterFn)(util::ADCFilterState &, uint32_t);
+
+  // Deep history of raw pitch values (same as raw_pitch_value), each channel
+  // is updated at its scan_rate (every tick with ADC_DMA_SCAN)
+  static constexpr size_t kDeepHistoryDepth = 128;
+#ifdef ADC_DMA_SCAN
+  static constexpr uint32_t kDefaultHistoryDecimation = 6; // ~260Hz
+#else
+  static constexpr uint32_t kDefaultHistoryDecimation = 4; // ~260Hz
+#endif
+  typedef util::HistoryRing<int16_t, kDeepHistoryDepth> DeepHistory;
+
+  // Frequency of upwards zero crossings (of the raw pitch value), timed in
+  // cycles from the conversion tick and interpolated between conversions
+  typedef util::FrequencyCounter<F_CPU> FrequencyCounter;
+  static constexpr uint32_t kCyclesPerTick = F_CPU / 1000000 * OC_CORE_TIMER_RATE;
+  static constexpr uint32_t kFrequencyGateTime = F_CPU / 10;
+  static constexpr uint32_t kFrequencyTimeout = F_CPU;
+  static constexpr int32_t kZeroCrossingHysteresis = 64;
+
 
   struct CalibrationData {
     uint16_t offset[ADC_CHANNEL_LAST];
@@ -48,18 +106,20 @@ public:
 
   // Read the value of the last conversion and update current channel, then
   // start the next conversion. If necessary, some channels could be given
-  // priority by scanning them more often. Even better might be some kind of
-  // continuous/DMA sampling to make things even more independent of the main
-  // ISR timing restrictions.
+  // priority by scanning them more often.
+  // With ADC_DMA_SCAN, all channels are converted continuously by DMA and
+  // this only reads the latest complete block, if there is a new one.
   static void Scan();
 
+  // Calibrated and pitch-scaled values are calculated once when a channel is
+  // updated in Scan, so these are just lookups.
   template <ADC_CHANNEL channel>
   static int32_t value() {
-    return calibration_data_->offset[channel] - (smoothed_[channel] >> kAdcValueShift);
+    return values_[channel].value;
   }
 
   static int32_t value(ADC_CHANNEL channel) {
-    return calibration_data_->offset[channel] - (smoothed_[channel] >> kAdcValueShift);
+    return values_[channel].value;
   }
 
   static uint32_t raw_value(ADC_CHANNEL channel) {
@@ -71,12 +131,64 @@ public:
   }
 
   static int32_t pitch_value(ADC_CHANNEL channel) {
-    return (value(channel) * calibration_data_->pitch_cv_scale) >> 12;
+    return values_[channel].pitch;
   }
 
   static int32_t raw_pitch_value(ADC_CHANNEL channel) {
-    int32_t value = calibration_data_->offset[channel] - raw_value(channel);
-    return (value * calibration_data_->pitch_cv_scale) >> 12;
+    return values_[channel].raw_pitch;
+  }
+
+  // Raw pitch value of channel changed by more than the threshold in the last
+  // Scan. Only valid for the current tick, so this is meant to be used from
+  // the ISR, e.g. for early-outs.
+  static bool changed(ADC_CHANNEL channel, ADC_CHANGE_THRESHOLD threshold = ADC_CHANGE_DEFAULT) {
+    return changed_[threshold] & (1U << channel);
+  }
+
+  // Tick (OC::CORE::ticks) in which the conversion of the current value was
+  // started; this is conservative, the conversion might have started later.
+  static uint32_t conversion_tick(ADC_CHANNEL channel) {
+    return conversion_ticks_[channel];
+  }
+
+  // Current value is the first (or a later) one converted after tick, e.g.
+  // a clock edge seen by an applet in that tick.
+  static bool converted_after(ADC_CHANNEL channel, uint32_t tick) {
+    return static_cast<int32_t>(conversion_ticks_[channel] - tick) > 0;
+  }
+
+  // @return frequency in mHz, 0 if there are no zero crossings. Limited to
+  // half the channel's scan_rate.
+  static uint32_t frequency(ADC_CHANNEL channel) {
+    return frequency_counters_[channel].millihertz();
+  }
+
+  static DeepHistory::View history_snapshot(ADC_CHANNEL channel) {
+    return deep_history_[channel].Snapshot();
+  }
+
+  static uint32_t history_samples(ADC_CHANNEL channel) {
+    return deep_history_[channel].samples();
+  }
+
+  // Average 2^decimation values per history sample
+  static void set_history_decimation(uint32_t decimation) {
+    for (int i = ADC_CHANNEL_1; i < ADC_CHANNEL_LAST; ++i)
+      deep_history_[i].set_decimation(decimation);
+  }
+
+  static void set_history_decimation(ADC_CHANNEL channel, uint32_t decimation) {
+    if (deep_history_[channel].decimation() != decimation)
+      deep_history_[channel].set_decimation(decimation);
+  }
+
+  static uint32_t history_decimation(ADC_CHANNEL channel) {
+    return deep_history_[channel].decimation();
+  }
+
+  // Stop updating the history of channel, e.g. to freeze a scope
+  static void hold_history(ADC_CHANNEL channel, bool hold) {
+    deep_history_[channel].set_hold(hold);
   }
 
 #ifdef ENABLE_ADC_DEBUG
@@ -92,21 +204,72 @@ public:
   static uint32_t busy_waits() {
     return busy_waits_;
   }
+
+#ifdef ADC_DMA_SCAN
+  // Scans without a new block
+  static uint32_t stale_scans() {
+    return stale_scans_;
+  }
+#endif
 #endif
 
   static void CalibratePitch(int32_t c2, int32_t c4);
 
+  static void set_filter_profile(ADC_CHANNEL channel, ADC_FILTER_PROFILE profile);
+
+  static ADC_FILTER_PROFILE filter_profile(ADC_CHANNEL channel) {
+    return filter_profiles_[channel];
+  }
+
+  // Give channels more (or fewer) conversion slots in the scan, e.g. for
+  // inputs with fast signals. Weights are relative, each channel gets at least
+  // one slot; nullptr for equal weights. Only applies to the round-robin scan,
+  // with ADC_DMA_SCAN all channels are converted continuously anyway.
+  // Note that smoothing and deep history are per update, so they scale with
+  // the channel's rate.
+  static void set_scan_weights(const uint8_t *weights);
+
+  // Effective update rate of channel in Hz
+  static uint32_t scan_rate(ADC_CHANNEL channel);
+
+  // Packed for global settings, 2 bits per channel
+  static void restore_filter_profiles(uint8_t profiles);
+  static uint8_t store_filter_profiles();
+
 private:
 
   template <ADC_CHANNEL channel>
-  static void update(uint32_t value) {
-    value = (value  >> (kAdcScanResolution - kAdcResolution)) << kAdcSmoothBits;
+  static void update(uint32_t value, uint32_t conversion_tick) {
+    conversion_ticks_[channel] = conversion_tick;
+    value = ScanValue::raw(value);
     raw_[channel] = value;
-    // division should be shift if kAdcSmoothing is power-of-two
-    value = (smoothed_[channel] * (kAdcSmoothing - 1) + value) / kAdcSmoothing;
-    smoothed_[channel] = value;
+    const uint32_t smoothed = filters_[channel](filter_states_[channel], value);
+    smoothed_[channel] = smoothed;
+
+    const int32_t offset = calibration_data_->offset[channel];
+    const int32_t pitch_cv_scale = calibration_data_->pitch_cv_scale;
+    Values &values = values_[channel];
+    values.value = offset - (smoothed >> kAdcValueShift);
+    values.pitch = (values.value * pitch_cv_scale) >> 12;
+    values.raw_pitch = ((offset - (int32_t)(value >> kAdcValueShift)) * pitch_cv_scale) >> 12;
+
+    uint32_t changed = change_detectors_[channel].Update(values.raw_pitch, kChangeThresholds);
+    for (int t = 0; t < ADC_CHANGE_THRESHOLD_LAST; ++t)
+      changed_[t] |= ((changed >> t) & 1) << channel;
+
+    deep_history_[channel].Push(values.raw_pitch);
+
+    const uint32_t time = conversion_tick * kCyclesPerTick;
+    uint32_t crossing;
+    if (zero_crossings_[channel].Process(values.raw_pitch, time, crossing))
+      frequency_counters_[channel].Edge(crossing);
+    frequency_counters_[channel].Update(time);
   }
 
+#ifdef ADC_DMA_SCAN
+  static void InitDMAScan();
+#endif
+
   static ::ADC adc_;
   static size_t scan_channel_;
   static CalibrationData *calibration_data_;
@@ -114,8 +277,39 @@ private:
   static uint32_t raw_[ADC_CHANNEL_LAST];
   static uint32_t smoothed_[ADC_CHANNEL_LAST];
 
+  struct Values {
+    int32_t value;
+    int32_t pitch;
+    int32_t raw_pitch;
+  };
+  static Values values_[ADC_CHANNEL_LAST];
+
+  static const int32_t kChangeThresholds[ADC_CHANGE_THRESHOLD_LAST];
+  static util::ADCChangeDetector<ADC_CHANGE_THRESHOLD_LAST> change_detectors_[ADC_CHANNEL_LAST];
+  static uint32_t changed_[ADC_CHANGE_THRESHOLD_LAST];
+  static uint32_t conversion_ticks_[ADC_CHANNEL_LAST];
+  static DeepHistory deep_history_[ADC_CHANNEL_LAST];
+  static util::ZeroCrossingDetector zero_crossings_[ADC_CHANNEL_LAST];
+  static FrequencyCounter frequency_counters_[ADC_CHANNEL_LAST];
+
+  static FilterFn filters_[ADC_CHANNEL_LAST];
+  static util::ADCFilterState filter_states_[ADC_CHANNEL_LAST];
+  static ADC_FILTER_PROFILE filter_profiles_[ADC_CHANNEL_LAST];
+
+#ifdef ADC_DMA_SCAN
+  typedef util::ADCScanRing<ADC_CHANNEL_LAST, kAdcScanBlocks> ScanRing;
+  static ScanRing scan_ring_;
+  static uint32_t mux_sequence_[ADC_CHANNEL_LAST];
+#else
+  typedef util::ADCScanSchedule<ADC_CHANNEL_LAST, kAdcScanSlots> ScanSchedule;
+  static ScanSchedule scan_schedule_;
+#endif
+
 #ifdef ENABLE_ADC_DEBUG
   static volatile uint32_t busy_waits_;
+#ifdef ADC_DMA_SCAN
+  static volatile uint32_t stale_scans_;
+#endif
 #endif
 };
 
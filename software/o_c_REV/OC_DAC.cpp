@@ -49,6 +49,7 @@ namespace OC {
 void DAC::Init(CalibrationData *calibration_data) {
 
   calibration_data_ = calibration_data;
+  update_pitch_luts();
   
   restore_scaling(0x0);
 
@@ -62,8 +63,19 @@ void DAC::Init(CalibrationData *calibration_data) {
     digitalWrite(DAC_RST, HIGH);
   #endif
 
-  history_tail_ = 0;
-  memset(history_, 0, sizeof(uint16_t) * kHistoryDepth * DAC_CHANNEL_LAST);
+  for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i) {
+    written_[i] = kInvalidValue;
+    history_head_[i] = 0;
+    history_[i][0].value = 0;
+    history_[i][0].ticks = kHistoryDepth;
+    skipped_writes_[i] = skipped_writes_stat_[i] = 0;
+    deep_history_[i].Init(0);
+    deep_history_[i].set_decimation(kDefaultHistoryDecimation);
+  }
+  stats_ticks_ = 0;
+  ramps_active_ = 0;
+  ramps_valid_ = 0;
+  memset(ramps_, 0, sizeof(ramps_));
 
   if (F_BUS == 60000000 || F_BUS == 48000000) 
     SPIFIFO.begin(DAC_CS, SPICLOCK_30MHz, SPI_MODE0);  
@@ -92,6 +104,7 @@ void DAC::set_auto_channel_calibration_data(uint8_t channel_id) {
         const OC::Autotune_data &autotune_data = OC::AUTOTUNE::GetAutotune_data(channel_id);
         for (int i = 0; i < OCTAVES + 1; i++)
           calibration_data_->calibrated_octaves[channel_id][i] = autotune_data.auto_calibrated_octaves[i];
+        update_pitch_luts();
     } 
   }
 }
@@ -105,6 +118,7 @@ void DAC::set_default_channel_calibration_data(uint8_t channel_id) {
     // reset data
     for (int i = 0; i < OCTAVES + 1; i++) 
       calibration_data_->calibrated_octaves[channel_id][i] = OC::calibration_data.dac.calibrated_octaves[channel_id][i];
+    update_pitch_luts();
     // + update info
     OC::Autotune_data *autotune_data = &OC::auto_calibration_data[channel_id];
     if (autotune_data->use_auto_calibration_ == 0xFF || autotune_data->use_auto_calibration_ == 0x01)
@@ -185,6 +199,12 @@ void DAC::restore_scaling(uint32_t scaling) {
     set_scaling(_scaling, i);
   }
 }
+/*static*/
+void DAC::update_pitch_luts() {
+  for (int i = 0; i < DAC_CHANNEL_LAST; i++)
+    pitch_luts_[i].Init(calibration_data_->calibrated_octaves[i]);
+}
+/*static*/
 uint32_t DAC::store_scaling() {
 
   uint32_t _scaling = 0;
@@ -198,11 +218,41 @@ DAC::CalibrationData *DAC::calibration_data_ = nullptr;
 /*static*/
 uint32_t DAC::values_[DAC_CHANNEL_LAST];
 /*static*/
-uint16_t DAC::history_[DAC_CHANNEL_LAST][DAC::kHistoryDepth];
+uint32_t DAC::written_[DAC_CHANNEL_LAST];
+/*static*/
+DAC::HistoryRun DAC::history_[DAC_CHANNEL_LAST][DAC::kHistoryDepth];
 /*static*/ 
-volatile size_t DAC::history_tail_;
+volatile size_t DAC::history_head_[DAC_CHANNEL_LAST];
+/*static*/
+DAC::DeepHistory DAC::deep_history_[DAC_CHANNEL_LAST];
+/*static*/
+uint32_t DAC::stats_ticks_;
+/*static*/
+uint32_t DAC::skipped_writes_[DAC_CHANNEL_LAST];
+/*static*/
+uint32_t DAC::skipped_writes_stat_[DAC_CHANNEL_LAST];
 /*static*/ 
 uint8_t DAC::DAC_scaling[DAC_CHANNEL_LAST];
+/*static*/
+DAC::Ramp DAC::ramps_[DAC_CHANNEL_LAST];
+/*static*/
+volatile uint32_t DAC::ramps_active_;
+volatile uint32_t DAC::ramps_valid_;
+/*static*/
+util::PitchLUT<OCTAVES> DAC::pitch_luts_[DAC_CHANNEL_LAST];
+/*static*/
+const util::PitchScaling DAC::kVoltageScalings[VOLTAGE_SCALING_LAST] = {
+  { 1, 0 },       // 1V/oct
+  { 25548, 15 },  // Wendy Carlos alpha scale - scale by 0.77995, 2^15 * 0.77995 = 25547.571
+  { 20917, 15 },  // Wendy Carlos beta scale - scale by 0.63833, 2^15 * 0.63833 = 20916.776
+  { 11501, 15 },  // Wendy Carlos gamma scale - scale by 0.35099, 2^15 * 0.35099 = 11501.2403
+  { 25969, 14 },  // Bohlen-Pierce macrotonal scale - scale by 1.585, 2^14 * 1.585 = 25968.64
+  { 1, 1 },       // Quartertone scaling (just down-scales to 0.5V/oct)
+  #ifdef BUCHLA_SUPPORT
+  { 19661, 14 },  // 1.2V/oct
+  { 2, 0 },       // 2V/oct
+  #endif
+};
 }; // namespace OC
 
 void set8565_CHA(uint32_t data) {
@@ -7,6 +7,8 @@
 #include "OC_options.h"
 #include "util/util_math.h"
 #include "util/util_macros.h"
+#include "util/util_history_ring.h"
+#include "util/util_pitch_lut.h"
 
 extern void set8565_CHA(uint32_t data);
 extern void set8565_CHB(uint32_t data);
@@ -37,6 +39,9 @@ namespace OC {
 class DAC {
 public:
   static constexpr size_t kHistoryDepth = 8;
+  static constexpr size_t kDeepHistoryDepth = 128;
+  static constexpr uint32_t kDefaultHistoryDecimation = 6; // ~260Hz
+  typedef util::HistoryRing<uint16_t, kDeepHistoryDepth> DeepHistory;
   static constexpr uint16_t MAX_VALUE = 65535; // DAC fullscale 
 
   #ifdef BUCHLA_4U
@@ -62,18 +67,30 @@ public:
   static void restore_scaling(uint32_t scaling);
   static uint8_t get_voltage_scaling(uint8_t channel_id);
   static uint32_t store_scaling();
+
+  // Rebuild pitch lookup from calibration data, needs to be called whenever
+  // calibrated_octaves is modified.
+  static void update_pitch_luts();
   
   static void set_all(uint32_t value) {
+    ramps_active_ = 0;
+    ramps_valid_ = 0;
     for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i)
       values_[i] = USAT16(value);
   }
 
+  // Setting a value directly cancels any active ramp on the channel, and the
+  // next ramp starts at its target since the pitch isn't known
   template <DAC_CHANNEL channel>
   static void set(uint32_t value) {
+    ramps_active_ &= ~(0x1 << channel);
+    ramps_valid_ &= ~(0x1 << channel);
     values_[channel] = USAT16(value);
   }
 
   static void set(DAC_CHANNEL channel, uint32_t value) {
+    ramps_active_ &= ~(0x1 << channel);
+    ramps_valid_ &= ~(0x1 << channel);
     values_[channel] = USAT16(value);
   }
 
@@ -96,19 +113,7 @@ public:
   // @return DAC output value
   static int32_t pitch_to_dac(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset) {
     pitch += (kOctaveZero + octave_offset) * 12 << 7;
-    
-    CONSTRAIN(pitch, 0, (120 << 7));
-
-    const int32_t octave = pitch / (12 << 7);
-    const int32_t fractional = pitch - octave * (12 << 7);
-
-    int32_t sample = calibration_data_->calibrated_octaves[channel][octave];
-    if (fractional) {
-      int32_t span = calibration_data_->calibrated_octaves[channel][octave + 1] - sample;
-      sample += (fractional * span) / (12 << 7);
-    }
-
-    return sample;
+    return pitch_luts_[channel].lookup(pitch);
   }
 
   // Specialised versions with voltage scaling
@@ -119,53 +124,10 @@ public:
   
   static int32_t pitch_to_scaled_voltage_dac(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset, uint8_t voltage_scaling) {
     pitch += (octave_offset * 12) << 7;
-
- 
-    switch (voltage_scaling) {
-      case VOLTAGE_SCALING_1V_PER_OCT:    // 1V/oct
-          // do nothing
-          break;
-      case VOLTAGE_SCALING_CARLOS_ALPHA:  // Wendy Carlos alpha scale - scale by 0.77995
-          pitch = (pitch * 25548) >> 15;  // 2^15 * 0.77995 = 25547.571
-          break;
-      case VOLTAGE_SCALING_CARLOS_BETA:   // Wendy Carlos beta scale - scale by 0.63833 
-          pitch = (pitch * 20917) >> 15;  // 2^15 * 0.63833 = 20916.776
-          break;
-      case VOLTAGE_SCALING_CARLOS_GAMMA:  // Wendy Carlos gamma scale - scale by 0.35099
-          pitch = (pitch * 11501) >> 15;  // 2^15 * 0.35099 = 11501.2403
-          break;
-      case VOLTAGE_SCALING_BOHLEN_PIERCE: // Bohlen-Pierce macrotonal scale - scale by 1.585
-          pitch = (pitch * 25969) >> 14;  // 2^14 * 1.585 = 25968.64
-          break;
-      case VOLTAGE_SCALING_QUARTERTONE:   // Quartertone scaling (just down-scales to 0.5V/oct)
-          pitch = pitch >> 1;
-          break;
-      #ifdef BUCHLA_SUPPORT
-      case VOLTAGE_SCALING_1_2V_PER_OCT:  // 1.2V/oct
-          pitch = (pitch * 19661) >> 14;
-          break;
-      case VOLTAGE_SCALING_2V_PER_OCT:    // 2V/oct
-          pitch = pitch << 1;
-          break;
-      #endif    
-      default: 
-          break;
-    }
-
+    if (voltage_scaling < VOLTAGE_SCALING_LAST)
+      pitch = kVoltageScalings[voltage_scaling].scale(pitch);
     pitch += (kOctaveZero * 12) << 7;
-   
-    CONSTRAIN(pitch, 0, (120 << 7));
-
-    const int32_t octave = pitch / (12 << 7);
-    const int32_t fractional = pitch - octave * (12 << 7);
-
-    int32_t sample = calibration_data_->calibrated_octaves[channel][octave];
-    if (fractional) {
-      int32_t span = calibration_data_->calibrated_octaves[channel][octave + 1] - sample;
-      sample += (fractional * span) / (12 << 7);
-    }
-
-    return sample;
+    return pitch_luts_[channel].lookup(pitch);
   }
     
   // Set channel to semitone value
@@ -183,6 +145,53 @@ public:
   // Set channel to pitch value
   static void set_pitch(DAC_CHANNEL channel, int32_t pitch, int32_t octave_offset) {
     set(channel, pitch_to_dac(channel, pitch, octave_offset));
+    ramps_[channel].pitch = (pitch + ((octave_offset * 12) << 7)) << kRampShift;
+    ramps_valid_ |= (0x1 << channel);
+  }
+
+  // Output ramps: Instead of calculating intermediate values at control rate,
+  // the target pitch is set once and the output is advanced in Update(). A
+  // ramp starts at the last value set with set_pitch (or the current position
+  // of a running ramp) and runs until the target is reached, or a value is
+  // set directly. If the channel was last set directly, the output jumps to
+  // the target instead. Pitch values are as for set_pitch with
+  // octave_offset = 0.
+
+  // Linear ramp to pitch over the given number of ticks
+  static void set_pitch_ramp(DAC_CHANNEL channel, int32_t pitch, uint32_t ticks) {
+    sync_ramp(channel, pitch);
+    int32_t distance = (pitch << kRampShift) - ramps_[channel].pitch;
+    if (distance < 0) distance = -distance;
+    if (ticks > 1) distance = (distance + ticks - 1) / ticks;
+    start_ramp(channel, pitch, RAMP_LINEAR, distance ? distance : 1);
+  }
+
+  // Linear ramp to pitch with fixed rate (pitch << kRampShift per tick), i.e.
+  // a slew rate limiter when called with a changing target
+  static void set_pitch_ramp_rate(DAC_CHANNEL channel, int32_t pitch, int32_t rate) {
+    start_ramp(channel, pitch, RAMP_LINEAR, rate > 0 ? rate : 1);
+  }
+
+  // Exponential (one-pole) ramp to pitch, covering 1/2^shift of the
+  // remaining distance each tick
+  static void set_pitch_slew(DAC_CHANNEL channel, int32_t pitch, int32_t shift) {
+    start_ramp(channel, pitch, RAMP_EXPONENTIAL, shift);
+  }
+
+  // Stop a running ramp where it is, e.g. when the applet that started it
+  // stops. As after a direct set, the next ramp starts at its target.
+  static void cancel_ramp(DAC_CHANNEL channel) {
+    ramps_active_ &= ~(0x1 << channel);
+    ramps_valid_ &= ~(0x1 << channel);
+  }
+
+  // Current ramp position, or last value from set_pitch
+  static int32_t ramp_pitch(DAC_CHANNEL channel) {
+    return ramps_[channel].pitch >> kRampShift;
+  }
+
+  static bool ramp_active(DAC_CHANNEL channel) {
+    return ramps_active_ & (0x1 << channel);
   }
 
   // Set integer voltage value, where 0 = 0V, 1 = 1V
@@ -206,42 +215,175 @@ public:
     return calibration_data_->calibrated_octaves[channel][kOctaveZero + octave];
   }
 
+  // Channels are only written if their value has changed since the last
+  // update; the DAC holds the previous value otherwise. The history is kept
+  // as runs of identical values so skipped updates still show up as ticks.
   static void Update() {
+    if (ramps_active_)
+      update_ramps();
 
-    set8565_CHA(values_[DAC_CHANNEL_A]);
-    set8565_CHB(values_[DAC_CHANNEL_B]);
-    set8565_CHC(values_[DAC_CHANNEL_C]);
-    set8565_CHD(values_[DAC_CHANNEL_D]);
+    update_channel<DAC_CHANNEL_A>(set8565_CHA);
+    update_channel<DAC_CHANNEL_B>(set8565_CHB);
+    update_channel<DAC_CHANNEL_C>(set8565_CHC);
+    update_channel<DAC_CHANNEL_D>(set8565_CHD);
 
-    size_t tail = history_tail_;
-    history_[DAC_CHANNEL_A][tail] = values_[DAC_CHANNEL_A];
-    history_[DAC_CHANNEL_B][tail] = values_[DAC_CHANNEL_B];
-    history_[DAC_CHANNEL_C][tail] = values_[DAC_CHANNEL_C];
-    history_[DAC_CHANNEL_D][tail] = values_[DAC_CHANNEL_D];
-    history_tail_ = (tail + 1) % kHistoryDepth;
+    for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i)
+      deep_history_[i].Push(values_[i]);
+
+    if (++stats_ticks_ >= kStatsWindow) {
+      for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i) {
+        skipped_writes_stat_[i] = skipped_writes_[i];
+        skipped_writes_[i] = 0;
+      }
+      stats_ticks_ = 0;
+    }
   }
 
+  // Get the last kHistoryDepth values, oldest first
   template <DAC_CHANNEL channel>
   static void getHistory(uint16_t *dst){
-    size_t head = (history_tail_ + 1) % kHistoryDepth;
+    size_t head = history_head_[channel];
+    uint16_t *end = dst + kHistoryDepth;
+    uint16_t value = 0;
+    for (size_t runs = 0; runs < kHistoryDepth && end > dst; ++runs) {
+      const HistoryRun run = history_[channel][head];
+      value = run.value;
+      size_t ticks = run.ticks;
+      while (ticks-- && end > dst)
+        *--end = value;
+      head = (head + kHistoryDepth - 1) % kHistoryDepth;
+    }
+    while (end > dst)
+      *--end = value;
+  }
 
-    size_t count = kHistoryDepth - head;
-    const uint16_t *src = history_[channel] + head;
-    while (count--)
-      *dst++ = *src++;
+  // Zero-copy view of the deep output history; the values are decimated
+  // according to set_history_decimation.
+  static DeepHistory::View history_snapshot(DAC_CHANNEL channel) {
+    return deep_history_[channel].Snapshot();
+  }
+
+  static uint32_t history_samples(DAC_CHANNEL channel) {
+    return deep_history_[channel].samples();
+  }
+
+  // Average 2^decimation values per history sample
+  static void set_history_decimation(uint32_t decimation) {
+    for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i)
+      deep_history_[i].set_decimation(decimation);
+  }
 
-    count = head;
-    src = history_[channel];
-    while (count--)
-      *dst++ = *src++;
+  // Percentage of skipped channel writes in last stats window (of kStatsWindow
+  // ticks)
+  static uint32_t skipped_writes_percent(DAC_CHANNEL channel) {
+    return (skipped_writes_stat_[channel] * 100) / kStatsWindow;
   }
 
+  static uint32_t skipped_writes_percent() {
+    uint32_t skipped = 0;
+    for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i)
+      skipped += skipped_writes_stat_[i];
+    return (skipped * 100) / (kStatsWindow * DAC_CHANNEL_LAST);
+  }
+
+  static constexpr int kRampShift = 14; // Same as Hemisphere simfloat
+
 private:
+  static constexpr uint32_t kStatsWindow = 16384;
+
+  enum RampMode {
+    RAMP_LINEAR,
+    RAMP_EXPONENTIAL
+  };
+
+  struct Ramp {
+    int32_t pitch;  // << kRampShift
+    int32_t target; // << kRampShift
+    int32_t mode;
+    int32_t param;  // rate or shift
+  };
+
+  static void sync_ramp(DAC_CHANNEL channel, int32_t pitch) {
+    if (!(ramps_valid_ & (0x1 << channel))) {
+      ramps_[channel].pitch = pitch << kRampShift;
+      ramps_valid_ |= (0x1 << channel);
+    }
+  }
+
+  static void start_ramp(DAC_CHANNEL channel, int32_t pitch, RampMode mode, int32_t param) {
+    sync_ramp(channel, pitch);
+    Ramp &ramp = ramps_[channel];
+    ramp.target = pitch << kRampShift;
+    ramp.mode = mode;
+    ramp.param = param;
+    ramps_active_ |= (0x1 << channel);
+  }
+
+  static void update_ramps() {
+    for (int channel = DAC_CHANNEL_A; channel < DAC_CHANNEL_LAST; ++channel) {
+      if (!(ramps_active_ & (0x1 << channel)))
+        continue;
+
+      Ramp &ramp = ramps_[channel];
+      int32_t pitch = ramp.pitch;
+      const int32_t remaining = ramp.target - pitch;
+      int32_t delta;
+      if (RAMP_LINEAR == ramp.mode) {
+        delta = remaining > ramp.param ? ramp.param : (remaining < -ramp.param ? -ramp.param : remaining);
+      } else {
+        delta = remaining >> ramp.param;
+        if (!delta) delta = remaining;
+      }
+      pitch += delta;
+      if (pitch == ramp.target)
+        ramps_active_ &= ~(0x1 << channel);
+
+      ramp.pitch = pitch;
+      values_[channel] = pitch_luts_[channel].lookup((pitch >> kRampShift) + ((kOctaveZero * 12) << 7));
+    }
+  }
+  static constexpr uint32_t kInvalidValue = 0xffffffff; // Forces write
+
+  struct HistoryRun {
+    uint16_t value;
+    uint16_t ticks; // saturates at kHistoryDepth
+  };
+
+  template <DAC_CHANNEL channel>
+  static inline void update_channel(void (*write_fn)(uint32_t)) {
+    const uint32_t value = values_[channel];
+    size_t head = history_head_[channel];
+    if (value != written_[channel]) {
+      write_fn(value);
+      written_[channel] = value;
+
+      head = (head + 1) % kHistoryDepth;
+      history_[channel][head].value = value;
+      history_[channel][head].ticks = 1;
+      history_head_[channel] = head;
+    } else {
+      ++skipped_writes_[channel];
+      HistoryRun &run = history_[channel][head];
+      if (run.ticks < kHistoryDepth)
+        ++run.ticks;
+    }
+  }
+
   static CalibrationData *calibration_data_;
   static uint32_t values_[DAC_CHANNEL_LAST];
-  static uint16_t history_[DAC_CHANNEL_LAST][kHistoryDepth];
-  static volatile size_t history_tail_;
+  static uint32_t written_[DAC_CHANNEL_LAST];
+  static HistoryRun history_[DAC_CHANNEL_LAST][kHistoryDepth];
+  static volatile size_t history_head_[DAC_CHANNEL_LAST];
+  static DeepHistory deep_history_[DAC_CHANNEL_LAST];
+  static uint32_t stats_ticks_;
+  static uint32_t skipped_writes_[DAC_CHANNEL_LAST];
+  static uint32_t skipped_writes_stat_[DAC_CHANNEL_LAST];
   static uint8_t DAC_scaling[DAC_CHANNEL_LAST];
+  static Ramp ramps_[DAC_CHANNEL_LAST];
+  static volatile uint32_t ramps_active_;
+  static volatile uint32_t ramps_valid_;
+  static util::PitchLUT<OCTAVES> pitch_luts_[DAC_CHANNEL_LAST];
+  static const util::PitchScaling kVoltageScalings[VOLTAGE_SCALING_LAST];
 };
 
 }; // namespace OC
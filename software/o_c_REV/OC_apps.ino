@@ -34,17 +34,38 @@
   prefix ## _isr \
 }
 
+// Apps are included as selected by the build profile (OC_build_profile.h)
 OC::App available_apps[] = {
+#if ENABLE_APP_HEMISPHERE
   DECLARE_APP('H','S', "Hemisphere", HEMISPHERE),
+#endif
+#if ENABLE_APP_MIDI
   DECLARE_APP('M','I', "Captain MIDI", MIDI),
+#endif
+#if ENABLE_APP_TheDarkestTimeline
   DECLARE_APP('D','2', "Darkest Timeline", TheDarkestTimeline),
+#endif
+#if ENABLE_APP_EnigmaTMWS
   DECLARE_APP('E','N', "Enigma", EnigmaTMWS),
+#endif
+#if ENABLE_APP_NeuralNetwork
   DECLARE_APP('N','N', "Neural Net", NeuralNetwork),
+#endif
+#if ENABLE_APP_SCALEEDITOR
   DECLARE_APP('S','C', "Scale Editor", SCALEEDITOR),
+#endif
+#if ENABLE_APP_WaveformEditor
   DECLARE_APP('W','A', "Waveform Editor", WaveformEditor),
+#endif
+#if ENABLE_APP_PONGGAME
   DECLARE_APP('P','O', "Pong", PONGGAME),
+#endif
+#if ENABLE_APP_Backup
   DECLARE_APP('B','R', "Backup / Restore", Backup),
+#endif
+#if ENABLE_APP_Settings
   DECLARE_APP('S','E', "Setup / About", Settings),
+#endif
 };
 
 static constexpr int NUM_AVAILABLE_APPS = ARRAY_SIZE(available_apps);
@@ -57,7 +78,7 @@ struct GlobalSettings {
   static constexpr uint32_t FOURCC = FOURCC<'O','C','S',2>::value;
 
   bool encoders_enable_acceleration;
-  bool reserved0;
+  uint8_t ADC_filters; // was reserved0, so 0 (default profiles) in older settings
   bool reserved1;
   uint32_t DAC_scaling;
   uint16_t current_app_id;
@@ -109,6 +130,7 @@ void save_global_settings() {
   memcpy(global_settings.auto_calibration_data, OC::auto_calibration_data, sizeof(OC::auto_calibration_data));
   // scaling settings:
   global_settings.DAC_scaling = OC::DAC::store_scaling();
+  global_settings.ADC_filters = OC::ADC::store_filter_profiles();
   
   global_settings_storage.Save(global_settings);
   SERIAL_PRINTLN("Saved global settings: page_index %d", global_settings_storage.page_index());
@@ -226,7 +248,7 @@ void Init(bool reset_settings) {
 
   global_settings.current_app_id = DEFAULT_APP_ID;
   global_settings.encoders_enable_acceleration = OC_ENCODERS_ENABLE_ACCELERATION_DEFAULT;
-  global_settings.reserved0 = false;
+  global_settings.ADC_filters = 0;
   global_settings.reserved1 = false;
   global_settings.DAC_scaling = VOLTAGE_SCALING_1V_PER_OCT; 
 
@@ -265,6 +287,7 @@ void Init(bool reset_settings) {
       memcpy(auto_calibration_data, global_settings.auto_calibration_data, sizeof(auto_calibration_data));
       DAC::choose_calibration_data(); // either use default data, or auto_calibration_data
       DAC::restore_scaling(global_settings.DAC_scaling); // recover output scaling settings
+      ADC::restore_filter_profiles(global_settings.ADC_filters);
     }
 
     SERIAL_PRINTLN("Load app data: size is %u, PAGESIZE=%u, PAGES=%u, LENGTH=%u",
@@ -376,8 +399,6 @@ void Ui::AppSettings() {
 
   if (change_app) {
     apps::set_current_app(cursor.cursor_pos());
-    FreqMeasure.end();
-    OC::DigitalInputs::reInit();
     if (save) {
       save_global_settings();
       save_app_data();
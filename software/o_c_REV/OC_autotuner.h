@@ -150,9 +150,9 @@ private:
         graphics.print("arm > ");
         float _freq = owner_->get_auto_frequency();
         if (_freq == 0.0f)
-          graphics.printf("wait ...");
+          graphics.print("wait ...");
         else 
-          graphics.printf("%7.3f", _freq);
+          graphics.print_fixed(static_cast<int32_t>(_freq * 1000.0f), 1000, 3, false, 7);
         }
         break;
         case AT_RUN:
@@ -169,7 +169,10 @@ private:
             if (!owner_->_ready())
               graphics.print(" ");
             else 
-              graphics.printf(" > %7.3f", owner_->get_auto_frequency());
+            {
+              graphics.print(" > ");
+              graphics.print_fixed(static_cast<int32_t>(owner_->get_auto_frequency() * 1000.0f), 1000, 3, false, 7);
+            }
           }
         }
         break;
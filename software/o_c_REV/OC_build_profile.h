@@ -0,0 +1,76 @@
+#ifndef OC_BUILD_PROFILE_H_
+#define OC_BUILD_PROFILE_H_
+//
+// GENERATED FILE, DO NOT EDIT
+// ./resources/build_profile.py resources/profiles/full.txt
+//
+#define OC_BUILD_PROFILE "full"
+
+// Apps (OC_apps.ino)
+#define ENABLE_APP_HEMISPHERE 1
+#define ENABLE_APP_MIDI 1
+#define ENABLE_APP_TheDarkestTimeline 1
+#define ENABLE_APP_EnigmaTMWS 1
+#define ENABLE_APP_NeuralNetwork 1
+#define ENABLE_APP_SCALEEDITOR 1
+#define ENABLE_APP_WaveformEditor 1
+#define ENABLE_APP_PONGGAME 1
+#define ENABLE_APP_Backup 1
+#define ENABLE_APP_Settings 1
+
+// Hemisphere applets (hemisphere_config.h)
+#define ENABLE_APPLET_ADSREG 1
+#define ENABLE_APPLET_ADEG 1
+#define ENABLE_APPLET_AnnularFusion 1
+#define ENABLE_APPLET_ASR 1
+#define ENABLE_APPLET_AttenuateOffset 1
+#define ENABLE_APPLET_Binary 1
+#define ENABLE_APPLET_BootsNCat 1
+#define ENABLE_APPLET_Brancher 1
+#define ENABLE_APPLET_Burst 1
+#define ENABLE_APPLET_Calculate 1
+#define ENABLE_APPLET_Carpeggio 1
+#define ENABLE_APPLET_ClockDivider 1
+#define ENABLE_APPLET_ClockSkip 1
+#define ENABLE_APPLET_Compare 1
+#define ENABLE_APPLET_CVRecV2 1
+#define ENABLE_APPLET_DrCrusher 1
+#define ENABLE_APPLET_DualQuant 1
+#define ENABLE_APPLET_EnigmaJr 1
+#define ENABLE_APPLET_EnvFollow 1
+#define ENABLE_APPLET_GateDelay 1
+#define ENABLE_APPLET_GatedVCA 1
+#define ENABLE_APPLET_LoFiPCM 1
+#define ENABLE_APPLET_Logic 1
+#define ENABLE_APPLET_LowerRenz 1
+#define ENABLE_APPLET_Metronome 1
+#define ENABLE_APPLET_hMIDIIn 1
+#define ENABLE_APPLET_hMIDIOut 1
+#define ENABLE_APPLET_MixerBal 1
+#define ENABLE_APPLET_Palimpsest 1
+#define ENABLE_APPLET_RunglBook 1
+#define ENABLE_APPLET_ScaleDuet 1
+#define ENABLE_APPLET_Schmitt 1
+#define ENABLE_APPLET_Scope 1
+#define ENABLE_APPLET_Sequence5 1
+#define ENABLE_APPLET_ShiftGate 1
+#define ENABLE_APPLET_TM 1
+#define ENABLE_APPLET_Shuffle 1
+#define ENABLE_APPLET_SkewedLFO 1
+#define ENABLE_APPLET_Slew 1
+#define ENABLE_APPLET_Squanch 1
+#define ENABLE_APPLET_Switch 1
+#define ENABLE_APPLET_TLNeuron 1
+#define ENABLE_APPLET_Trending 1
+#define ENABLE_APPLET_TrigSeq 1
+#define ENABLE_APPLET_TrigSeq16 1
+#define ENABLE_APPLET_Tuner 1
+#define ENABLE_APPLET_VectorEG 1
+#define ENABLE_APPLET_VectorLFO 1
+#define ENABLE_APPLET_VectorMod 1
+#define ENABLE_APPLET_VectorMorph 1
+#define ENABLE_APPLET_Voltage 1
+
+#define HEMISPHERE_PROFILE_APPLET_COUNT 51
+
+#endif // OC_BUILD_PROFILE_H_
@@ -1,6 +1,8 @@
 #ifndef OC_CONFIG_H_
 #define OC_CONFIG_H_
 
+#include "OC_build_profile.h"
+
 #if F_CPU != 120000000
 #error "Please compile O&C firmware with CPU speed 120MHz"
 #endif
@@ -19,7 +21,10 @@ static constexpr int OC_CORE_TIMER_PRIO = 80;  // yet higher
 static constexpr int OC_GPIO_ISR_PRIO   = 112; // higher
 static constexpr int OC_UI_TIMER_PRIO   = 128; // default
 
-static constexpr unsigned long REDRAW_TIMEOUT_MS = 1;
+// Redraw rate of the main loop, and ISR load (% of the ISR period) above which
+// frames are dropped to leave time for background work
+static constexpr uint32_t OC_DISPLAY_FPS = 60;
+static constexpr uint32_t OC_DISPLAY_MAX_ISR_LOAD = 75;
 static constexpr uint32_t SCREENSAVER_TIMEOUT_S = 25; // default time out menu (in s)
 static constexpr uint32_t SCREENSAVER_TIMEOUT_MAX_S = 120;
 
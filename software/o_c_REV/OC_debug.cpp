@@ -1,6 +1,7 @@
 #include <Arduino.h>
 #include "OC_ADC.h"
 #include "OC_config.h"
+#include "OC_DAC.h"
 #include "OC_core.h"
 #include "OC_debug.h"
 #include "OC_menus.h"
@@ -52,28 +53,58 @@ namespace DEBUG {
   }
 }; // namespace DEBUG
 
+static void print_min_avg_max(uint32_t min_value, uint32_t value, uint32_t max_value) {
+  graphics.print(min_value, 3);
+  graphics.print('/');
+  graphics.print(value, 3);
+  graphics.print('/');
+  graphics.print(max_value, 3);
+}
+
+template <ADC_CHANNEL channel>
+static void print_adc_channel() {
+  graphics.print("CV");
+  graphics.print(static_cast<int>(channel) + 1);
+  graphics.print(' ');
+  graphics.print(static_cast<int>(ADC::value<channel>()), 5);
+  graphics.print(' ');
+  graphics.print(ADC::raw_value(channel), 4);
+  graphics.print(' ');
+  graphics.print(ADC::scan_rate(channel), 5);
+}
+
 static void debug_menu_core() {
 
   graphics.setPrintPos(2, 12);
-  graphics.printf("%uMHz %uus+%uus", F_CPU / 1000 / 1000, OC_CORE_TIMER_RATE, OC_UI_TIMER_RATE);
+  graphics.print(static_cast<uint32_t>(F_CPU / 1000 / 1000), 0);
+  graphics.print("MHz ");
+  graphics.print(OC_CORE_TIMER_RATE, 0);
+  graphics.print("us+");
+  graphics.print(OC_UI_TIMER_RATE, 0);
+  graphics.print("us");
   
   graphics.setPrintPos(2, 22);
   uint32_t isr_us = debug::cycles_to_us(DEBUG::ISR_cycles.value());
-  graphics.printf("CORE%3u/%3u/%3u %2u%%",
-                  debug::cycles_to_us(DEBUG::ISR_cycles.min_value()),
-                  isr_us,
-                  debug::cycles_to_us(DEBUG::ISR_cycles.max_value()),
-                  (isr_us * 100) /  OC_CORE_TIMER_RATE);
+  graphics.print("CORE");
+  print_min_avg_max(debug::cycles_to_us(DEBUG::ISR_cycles.min_value()),
+                    isr_us,
+                    debug::cycles_to_us(DEBUG::ISR_cycles.max_value()));
+  graphics.print(' ');
+  graphics.print((isr_us * 100) / OC_CORE_TIMER_RATE, 2);
+  graphics.print('%');
 
   graphics.setPrintPos(2, 32);
-  graphics.printf("POLL%3u/%3u/%3u",
-                  debug::cycles_to_us(DEBUG::UI_cycles.min_value()),
-                  debug::cycles_to_us(DEBUG::UI_cycles.value()),
-                  debug::cycles_to_us(DEBUG::UI_cycles.max_value()));
+  graphics.print("POLL");
+  print_min_avg_max(debug::cycles_to_us(DEBUG::UI_cycles.min_value()),
+                    debug::cycles_to_us(DEBUG::UI_cycles.value()),
+                    debug::cycles_to_us(DEBUG::UI_cycles.max_value()));
 
 #ifdef OC_UI_DEBUG
   graphics.setPrintPos(2, 42);
-  graphics.printf("UI   !%u #%u", DEBUG::UI_queue_overflow, DEBUG::UI_event_count);
+  graphics.print("UI   !");
+  graphics.print(DEBUG::UI_queue_overflow, 0);
+  graphics.print(" #");
+  graphics.print(DEBUG::UI_event_count, 0);
   graphics.setPrintPos(2, 52);
 #endif
 }
@@ -85,24 +116,42 @@ static void debug_menu_gfx() {
   graphics.print("W");
 
   graphics.setPrintPos(2, 22);
-  graphics.printf("MENU %3u/%3u/%3u",
-                  debug::cycles_to_us(DEBUG::MENU_draw_cycles.min_value()),
-                  debug::cycles_to_us(DEBUG::MENU_draw_cycles.value()),
-                  debug::cycles_to_us(DEBUG::MENU_draw_cycles.max_value()));
+  graphics.print("MENU ");
+  print_min_avg_max(debug::cycles_to_us(DEBUG::MENU_draw_cycles.min_value()),
+                    debug::cycles_to_us(DEBUG::MENU_draw_cycles.value()),
+                    debug::cycles_to_us(DEBUG::MENU_draw_cycles.max_value()));
+
+  graphics.setPrintPos(2, 32);
+  graphics.print("PAGES skip ");
+  graphics.print(display::driver.skipped_pages_percent(), 3);
+  graphics.print('%');
+
+  graphics.setPrintPos(2, 42);
+  graphics.print("FPS ");
+  graphics.print(display::governor.fps(), 3);
+  graphics.print(" drop ");
+  graphics.print(display::governor.dropped_frames(), 0);
+
+  graphics.setPrintPos(2, 52);
+  graphics.print("SENT ");
+  graphics.print(display::driver.pages_sent(), 0);
+  graphics.print(" off ");
+  graphics.print(display::driver.suspended_ticks() / OC_CORE_ISR_FREQ, 0);
+  graphics.print('s');
 }
 
 static void debug_menu_adc() {
   graphics.setPrintPos(2, 12);
-  graphics.printf("CV1 %5d %5u", ADC::value<ADC_CHANNEL_1>(), ADC::raw_value(ADC_CHANNEL_1));
+  print_adc_channel<ADC_CHANNEL_1>();
 
   graphics.setPrintPos(2, 22);
-  graphics.printf("CV2 %5d %5u", ADC::value<ADC_CHANNEL_2>(), ADC::raw_value(ADC_CHANNEL_2));
+  print_adc_channel<ADC_CHANNEL_2>();
 
   graphics.setPrintPos(2, 32);
-  graphics.printf("CV3 %5d %5u", ADC::value<ADC_CHANNEL_3>(), ADC::raw_value(ADC_CHANNEL_3));
+  print_adc_channel<ADC_CHANNEL_3>();
 
   graphics.setPrintPos(2, 42);
-  graphics.printf("CV4 %5d %5u", ADC::value<ADC_CHANNEL_4>(), ADC::raw_value(ADC_CHANNEL_4));
+  print_adc_channel<ADC_CHANNEL_4>();
 
 //      graphics.setPrintPos(2, 42);
 //      graphics.print((long)ADC::busy_waits());
@@ -110,6 +159,24 @@ static void debug_menu_adc() {
 //      graphics.setPrintPos(2, 52); graphics.print(ADC::fail_flag1());
 }
 
+static void debug_menu_dac() {
+  graphics.setPrintPos(2, 12);
+  graphics.print("Skipped writes ");
+  graphics.print(DAC::skipped_writes_percent(), 3);
+  graphics.print('%');
+
+  for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i) {
+    graphics.setPrintPos(2, 22 + i * 10);
+    graphics.print("DAC");
+    graphics.print(static_cast<char>('A' + i));
+    graphics.print(' ');
+    graphics.print(DAC::value(i), 5);
+    graphics.print(' ');
+    graphics.print(DAC::skipped_writes_percent(static_cast<DAC_CHANNEL>(i)), 3);
+    graphics.print('%');
+  }
+}
+
 struct DebugMenu {
   const char *title;
   void (*display_fn)();
@@ -119,6 +186,7 @@ static const DebugMenu debug_menus[] = {
   { " CORE", debug_menu_core },
   { " GFX", debug_menu_gfx },
   { " ADC", debug_menu_adc },
+  { " DAC", debug_menu_dac },
 #ifdef POLYLFO_DEBUG  
   { " POLYLFO", POLYLFO_debug },
 #endif // POLYLFO_DEBUG
@@ -152,7 +220,9 @@ void Ui::DebugStats() {
 
     GRAPHICS_BEGIN_FRAME(false);
       graphics.setPrintPos(2, 2);
-      graphics.printf("%d/%u", (int)(current_menu - &debug_menus[0]) + 1, ARRAY_SIZE(debug_menus) - 1);
+      graphics.print((int)(current_menu - &debug_menus[0]) + 1);
+      graphics.print('/');
+      graphics.print((int)ARRAY_SIZE(debug_menus) - 1);
       graphics.print(current_menu->title);
       current_menu->display_fn();
     GRAPHICS_END_FRAME();
@@ -8,7 +8,19 @@
 uint32_t OC::DigitalInputs::clocked_mask_;
 
 /*static*/
-volatile uint32_t OC::DigitalInputs::clocked_[DIGITAL_INPUT_LAST];
+uint32_t OC::DigitalInputs::edge_counts_[DIGITAL_INPUT_LAST];
+
+/*static*/
+OC::DigitalInputs::EdgeQueue OC::DigitalInputs::edge_queues_[DIGITAL_INPUT_LAST];
+
+/*static*/
+OC::DigitalInputs::ClockPLL OC::DigitalInputs::clock_plls_[DIGITAL_INPUT_LAST];
+
+/*static*/
+OC::DigitalInputs::FrequencyCounter OC::DigitalInputs::frequency_counters_[DIGITAL_INPUT_LAST];
+
+/*static*/
+OC::DigitalInputs::EdgeTimestamp OC::DigitalInputs::edge_timestamps_[DIGITAL_INPUT_LAST];
 
 void FASTRUN tr1_ISR() {  
   OC::DigitalInputs::clock<OC::DIGITAL_INPUT_1>();
@@ -39,18 +51,33 @@ void OC::DigitalInputs::Init() {
     {TR4, tr4_ISR},
   };
 
-  for (auto pin : pins) {
+  // Edge timestamps need the cycle counter, which is otherwise only enabled
+  // by the debug menu
+  ARM_DEMCR |= ARM_DEMCR_TRCENA;
+  ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+  for (auto &timestamp : edge_timestamps_)
+    timestamp.Init();
+  for (auto &pll : clock_plls_)
+    pll.Init();
+  for (auto &counter : frequency_counters_)
+    counter.Init(kFrequencyGateTime, kFrequencyTimeout);
+
+  for (auto pin : pins)
     pinMode(pin.pin, OC_GPIO_TRx_PINMODE);
-    attachInterrupt(pin.pin, pin.isr_fn, FALLING);
-  }
 
   clocked_mask_ = 0;
-  std::fill(clocked_, clocked_ + DIGITAL_INPUT_LAST, 0);
+  std::fill(edge_counts_, edge_counts_ + DIGITAL_INPUT_LAST, 0);
+  edge_queues_[DIGITAL_INPUT_1].Init(read_immediate<DIGITAL_INPUT_1>());
+  edge_queues_[DIGITAL_INPUT_2].Init(read_immediate<DIGITAL_INPUT_2>());
+  edge_queues_[DIGITAL_INPUT_3].Init(read_immediate<DIGITAL_INPUT_3>());
+  edge_queues_[DIGITAL_INPUT_4].Init(read_immediate<DIGITAL_INPUT_4>());
 
-  // Assume the priority of pin change interrupts is lower or equal to the
-  // thread where ::Scan function is called. Otherwise a safer mechanism is
-  // required to avoid conflicts (LDREX/STREX or store ARM_DWT_CYCCNT in the
-  // array to check for changes.
+  for (auto pin : pins)
+    attachInterrupt(pin.pin, pin.isr_fn, CHANGE);
+
+  // The pin change interrupts only write to the edge queues, which are
+  // single-producer/single-consumer, so it doesn't matter if they have higher
+  // priority than the thread where ::Scan is called.
   //
   // A really nice approach would be to use the FTM timer mechanism and avoid
   // the ISR altogether, but this only works for one of the pins. Using more
@@ -65,22 +92,12 @@ void OC::DigitalInputs::Init() {
   // Defaults is 0, or set OC_GPIO_ISR_PRIO for all ports
 }
 
-void OC::DigitalInputs::reInit() {
-  // re-init TR4, to avoid conflict with the FTM
-  #ifdef FLIP_180
-    pinMode(TR1, OC_GPIO_TRx_PINMODE);
-    attachInterrupt(TR1, tr1_ISR, FALLING);
-  #else
-    pinMode(TR4, OC_GPIO_TRx_PINMODE);
-    attachInterrupt(TR4, tr4_ISR, FALLING);
-  #endif
-}
-
 /*static*/
 void OC::DigitalInputs::Scan() {
+  const uint32_t now = util::cycle_count();
   clocked_mask_ =
-    ScanInput<DIGITAL_INPUT_1>() |
-    ScanInput<DIGITAL_INPUT_2>() |
-    ScanInput<DIGITAL_INPUT_3>() |
-    ScanInput<DIGITAL_INPUT_4>();
+    ScanInput<DIGITAL_INPUT_1>(now) |
+    ScanInput<DIGITAL_INPUT_2>(now) |
+    ScanInput<DIGITAL_INPUT_3>(now) |
+    ScanInput<DIGITAL_INPUT_4>(now);
 }
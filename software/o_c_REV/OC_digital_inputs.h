@@ -5,6 +5,10 @@
 #include "OC_config.h"
 #include "OC_core.h"
 #include "OC_gpio.h"
+#include "util/util_clock_pll.h"
+#include "util/util_edge_queue.h"
+#include "util/util_edge_timestamp.h"
+#include "util/util_frequency_counter.h"
 
 namespace OC {
 
@@ -32,9 +36,26 @@ template <> struct InputPinDesc<DIGITAL_INPUT_4> { static constexpr int PIN = TR
 class DigitalInputs {
 public:
 
-  static void Init();
+  // Edges are timestamped with the cycle counter, times are in ticks with
+  // kEdgeFracBits fractional bits
+  static constexpr uint32_t kEdgeFracBits = 8;
+  typedef util::EdgeTimestamp<F_CPU / 1000000 * OC_CORE_TIMER_RATE, kEdgeFracBits> EdgeTimestamp;
+
+  // Rising and falling edges between scans; at 16 entries per input a burst
+  // of 8 pulses within a single tick doesn't lose any.
+  static constexpr size_t kEdgeQueueSize = 16;
+  typedef util::EdgeQueue<kEdgeQueueSize> EdgeQueue;
 
-  static void reInit();
+  // Each input has a period estimator that runs on every scan
+  typedef util::ClockPLL<kEdgeFracBits> ClockPLL;
+
+  // Frequency of rising edges, measured over kFrequencyGateTime and reset to
+  // 0 after kFrequencyTimeout without edges (in cycles)
+  typedef util::FrequencyCounter<F_CPU> FrequencyCounter;
+  static constexpr uint32_t kFrequencyGateTime = F_CPU / 20;
+  static constexpr uint32_t kFrequencyTimeout = F_CPU;
+
+  static void Init();
 
   static void Scan();
 
@@ -61,8 +82,56 @@ public:
     return !digitalReadFast(InputPinMap(input));
   }
 
+  // @return number of rising edges since last scan, including pulses that
+  // started and ended between scans
+  static inline uint32_t rising_edges(DigitalInput input) {
+    return edge_counts_[input] & 0xffff;
+  }
+
+  // @return number of falling edges since last scan
+  static inline uint32_t falling_edges(DigitalInput input) {
+    return edge_counts_[input] >> 16;
+  }
+
+  // @return gate state after the edges of the last scan
+  static inline bool gate(DigitalInput input) {
+    return edge_queues_[input].gate();
+  }
+
+  // @return number of edges lost because the queue was full
+  static inline uint32_t dropped_edges(DigitalInput input) {
+    return edge_queues_[input].dropped();
+  }
+
+  // @return cycle count of the latest rising edge
+  static inline uint32_t edge_cycles(DigitalInput input) {
+    return edge_timestamps_[input].cycles();
+  }
+
+  // @return time between the last two rising edges (0 if unknown)
+  static inline uint32_t edge_period(DigitalInput input) {
+    return edge_timestamps_[input].period();
+  }
+
+  // @return time between the latest rising edge and the tick it was reported
+  // in, i.e. the edge occurred edge_age before the clocked() tick
+  static inline uint32_t edge_age(DigitalInput input) {
+    return edge_timestamps_[input].age();
+  }
+
+  // @return smoothed period, phase and lock state of the input's clock
+  static inline const ClockPLL &clock_pll(DigitalInput input) {
+    return clock_plls_[input];
+  }
+
+  // @return frequency of rising edges in mHz, 0 if not clocked
+  static inline uint32_t frequency(DigitalInput input) {
+    return frequency_counters_[input].millihertz();
+  }
+
+  // Pin change ISR, inputs are inverted
   template <DigitalInput input> static inline void clock() {
-    clocked_[input] = 1;
+    edge_queues_[input].Push(util::cycle_count(), read_immediate<input>());
   }
 
 private:
@@ -79,14 +148,35 @@ private:
   }
 
   static uint32_t clocked_mask_;
-  static volatile uint32_t clocked_[DIGITAL_INPUT_LAST];
+  static uint32_t edge_counts_[DIGITAL_INPUT_LAST]; // falling << 16 | rising
+  static EdgeQueue edge_queues_[DIGITAL_INPUT_LAST];
+  static EdgeTimestamp edge_timestamps_[DIGITAL_INPUT_LAST];
+  static ClockPLL clock_plls_[DIGITAL_INPUT_LAST];
+  static FrequencyCounter frequency_counters_[DIGITAL_INPUT_LAST];
 
   template <DigitalInput input>
-  static uint32_t ScanInput() {
-    if (clocked_[input]) {
-      clocked_[input] = 0;
+  static uint32_t ScanInput(uint32_t now) {
+    uint32_t rising = 0, falling = 0;
+    uint32_t cycles;
+    bool is_rising;
+    while (edge_queues_[input].Pop(cycles, is_rising)) {
+      if (is_rising) {
+        edge_timestamps_[input].Edge(cycles);
+        frequency_counters_[input].Edge(cycles);
+        ++rising;
+      } else {
+        ++falling;
+      }
+    }
+    edge_counts_[input] = (falling << 16) | rising;
+    frequency_counters_[input].Update(now);
+
+    if (rising) {
+      edge_timestamps_[input].Scan(now);
+      clock_plls_[input].Update(true, edge_timestamps_[input].period(), edge_timestamps_[input].age());
       return DIGITAL_INPUT_MASK(input);
     } else {
+      clock_plls_[input].Update(false, 0, 0);
       return 0;
     }
   }
@@ -66,74 +66,47 @@ void screensaver() {
 
 static const size_t kScopeDepth = 64;
 
-uint16_t scope_history[DAC::kHistoryDepth];
-uint16_t averaged_scope_history[DAC_CHANNEL_LAST][kScopeDepth];
-size_t averaged_scope_tail = 0;
-DAC_CHANNEL scope_update_channel = DAC_CHANNEL_A;
-
-template <size_t size>
-inline uint16_t calc_average(const uint16_t *data) {
-  uint32_t sum = 0;
-  size_t n = size;
-  while (n--)
-    sum += *data++;
-  return sum / size;
-}
-
+// The scopes draw the most recent kScopeDepth samples straight from the DAC
+// history, which is already averaged by the history decimation.
 template <unsigned rshift, uint16_t bitmask>
-void scope_averaging() {
-    switch (scope_update_channel) {
-    case DAC_CHANNEL_A:
-      DAC::getHistory<DAC_CHANNEL_A>(scope_history);
-      averaged_scope_history[DAC_CHANNEL_A][averaged_scope_tail] = ((65535U - calc_average<DAC::kHistoryDepth>(scope_history)) >> rshift) & bitmask;
-      scope_update_channel = DAC_CHANNEL_B;
-      break;
-    case DAC_CHANNEL_B:
-      DAC::getHistory<DAC_CHANNEL_B>(scope_history);
-      averaged_scope_history[DAC_CHANNEL_B][averaged_scope_tail] = ((65535U - calc_average<DAC::kHistoryDepth>(scope_history)) >> rshift) & bitmask;
-      scope_update_channel = DAC_CHANNEL_C;
-      break;
-    case DAC_CHANNEL_C:
-      DAC::getHistory<DAC_CHANNEL_C>(scope_history);
-      averaged_scope_history[DAC_CHANNEL_C][averaged_scope_tail] = ((65535U - calc_average<DAC::kHistoryDepth>(scope_history)) >> rshift) & bitmask;
-      scope_update_channel = DAC_CHANNEL_D;
-      break;
-    case DAC_CHANNEL_D:
-      DAC::getHistory<DAC_CHANNEL_D>(scope_history);
-      averaged_scope_history[DAC_CHANNEL_D][averaged_scope_tail] = ((65535U - calc_average<DAC::kHistoryDepth>(scope_history)) >> rshift) & bitmask;
-      scope_update_channel = DAC_CHANNEL_A;
-      averaged_scope_tail = (averaged_scope_tail + 1) % kScopeDepth;
-      break;
-    default: break;
+struct ScopeHistory {
+  DAC::DeepHistory::View history[DAC_CHANNEL_LAST];
+
+  ScopeHistory() {
+    for (int i = DAC_CHANNEL_A; i < DAC_CHANNEL_LAST; ++i)
+      history[i] = DAC::history_snapshot(static_cast<DAC_CHANNEL>(i));
   }
-}
+
+  inline weegfx::coord_t operator()(DAC_CHANNEL channel, weegfx::coord_t x) const {
+    const DAC::DeepHistory::View &view = history[channel];
+    return ((65535U - view[view.length - kScopeDepth + 1 + x]) >> rshift) & bitmask;
+  }
+};
 
 void scope_render() {
-  scope_averaging<11, 0x1f>();
+  const ScopeHistory<11, 0x1f> scope;
 
   for (weegfx::coord_t x = 0; x < (weegfx::coord_t)kScopeDepth - 1; ++x) {
-    size_t index = (x + averaged_scope_tail + 1) % kScopeDepth;
     #ifdef BUCHLA_4U
-      graphics.setPixel(x, 0 + averaged_scope_history[DAC_CHANNEL_C][index]);
-      graphics.setPixel(64 + x, 0 + averaged_scope_history[DAC_CHANNEL_D][index]);
-      graphics.setPixel(x, 32 + averaged_scope_history[DAC_CHANNEL_A][index]);
-      graphics.setPixel(64 + x, 32 + averaged_scope_history[DAC_CHANNEL_B][index]);  
+      graphics.setPixel(x, 0 + scope(DAC_CHANNEL_C, x));
+      graphics.setPixel(64 + x, 0 + scope(DAC_CHANNEL_D, x));
+      graphics.setPixel(x, 32 + scope(DAC_CHANNEL_A, x));
+      graphics.setPixel(64 + x, 32 + scope(DAC_CHANNEL_B, x));
     #else
-      graphics.setPixel(x, 0 + averaged_scope_history[DAC_CHANNEL_A][index]);
-      graphics.setPixel(64 + x, 0 + averaged_scope_history[DAC_CHANNEL_B][index]);
-      graphics.setPixel(x, 32 + averaged_scope_history[DAC_CHANNEL_C][index]);
-      graphics.setPixel(64 + x, 32 + averaged_scope_history[DAC_CHANNEL_D][index]);
+      graphics.setPixel(x, 0 + scope(DAC_CHANNEL_A, x));
+      graphics.setPixel(64 + x, 0 + scope(DAC_CHANNEL_B, x));
+      graphics.setPixel(x, 32 + scope(DAC_CHANNEL_C, x));
+      graphics.setPixel(64 + x, 32 + scope(DAC_CHANNEL_D, x));
     #endif
   }
 }
 
 void vectorscope_render() {
-  scope_averaging<10, 0x3f>();
+  const ScopeHistory<10, 0x3f> scope;
 
   for (weegfx::coord_t x = 0; x < (weegfx::coord_t)kScopeDepth - 1; ++x) {
-    size_t index = (x + averaged_scope_tail + 1) % kScopeDepth;
-    graphics.setPixel(averaged_scope_history[DAC_CHANNEL_A][index], averaged_scope_history[DAC_CHANNEL_B][index]);
-    graphics.setPixel(64 + averaged_scope_history[DAC_CHANNEL_C][index], averaged_scope_history[DAC_CHANNEL_D][index]);
+    graphics.setPixel(scope(DAC_CHANNEL_A, x), scope(DAC_CHANNEL_B, x));
+    graphics.setPixel(64 + scope(DAC_CHANNEL_C, x), scope(DAC_CHANNEL_D, x));
   }
 }
 
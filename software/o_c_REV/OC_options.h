@@ -23,6 +23,10 @@
 //#define INVERT_DISPLAY
 /* ------------ use DAC8564 -------------------------------------------------------------------------  */
 //#define DAC8564
+/* ------------ continuous ADC scan of all channels using DMA ---------------------------------------  */
+//#define ADC_DMA_SCAN
+/* ------------ single display frame buffer (saves 1 KB RAM, drawing waits for display transfer) ----  */
+//#define DISPLAY_SINGLE_BUFFER
 
 #endif
 
@@ -34,6 +34,8 @@ namespace OC {
 
   const char * const encoder_config_strings[] = { "normal", "R reversed", "L reversed", "LR reversed" };
 
+  const char * const adc_filter_profiles[] = { "Dflt", "None", "Smth", "Adpt" };
+
   const char * const trigger_delay_times[kNumDelayTimes] = {
       "off", "120us", "240us", "360us", "480us", "1ms", "2ms", "4ms"
   };
@@ -42,6 +42,7 @@ void SortScale(Scale &scale) {
 void Quantizer::Init() {
   enabled_ = true;
   codeword_ = 0;
+  note_number_ = 64; // codeword_ in the default codebook
   transpose_ = 0;
   previous_boundary_ = 0;
   next_boundary_ = 0;
@@ -66,6 +66,11 @@ class Quantizer {
   // HACK for TM
   int32_t Lookup(int32_t index) const;
 
+  // Codebook index of the last quantized note (including transpose)
+  uint16_t note_number() const {
+    return note_number_;
+  }
+
   // Force Process to process again
   void Requantize();
 
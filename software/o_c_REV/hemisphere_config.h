@@ -11,60 +11,82 @@
 // * Category filtering is deprecated at 1.8, but I'm leaving the per-applet categorization
 // alone to avoid breaking forked codebases by other developers.
 
-#define HEMISPHERE_AVAILABLE_APPLETS 51
+#include "OC_build_profile.h"
+
+// Which applets are compiled in is selected by the build profile, see
+// resources/build_profile.py. The table below is the master list.
+#define HEMISPHERE_AVAILABLE_APPLETS HEMISPHERE_PROFILE_APPLET_COUNT
+
+#define PROFILE_APPLET(id, categories, class_name) \
+    PROFILE_IF(ENABLE_APPLET_ ## class_name, DECLARE_APPLET(id, categories, class_name))
+#define PROFILE_IF(enabled, ...) PROFILE_IF_(enabled, __VA_ARGS__)
+#define PROFILE_IF_(enabled, ...) PROFILE_IF_ ## enabled(__VA_ARGS__)
+#define PROFILE_IF_0(...)
+#define PROFILE_IF_1(...) __VA_ARGS__,
 
 //////////////////  id  cat   class name
 #define HEMISPHERE_APPLETS { \
-    DECLARE_APPLET(  8, 0x01, ADSREG), \
-    DECLARE_APPLET( 34, 0x01, ADEG), \
-    DECLARE_APPLET( 15, 0x02, AnnularFusion), \
-    DECLARE_APPLET( 47, 0x09, ASR), \
-    DECLARE_APPLET( 56, 0x10, AttenuateOffset), \
-    DECLARE_APPLET( 41, 0x41, Binary), \
-    DECLARE_APPLET( 51, 0x80, BootsNCat), \
-    DECLARE_APPLET(  4, 0x14, Brancher), \
-    DECLARE_APPLET( 31, 0x04, Burst), \
-    DECLARE_APPLET( 12, 0x10, Calculate),\
-    DECLARE_APPLET( 32, 0x0a, Carpeggio), \
-    DECLARE_APPLET(  6, 0x04, ClockDivider), \
-    DECLARE_APPLET( 28, 0x04, ClockSkip), \
-    DECLARE_APPLET( 30, 0x10, Compare), \
-    DECLARE_APPLET( 24, 0x02, CVRecV2), \
-    DECLARE_APPLET( 55, 0x80, DrCrusher), \
-    DECLARE_APPLET(  9, 0x08, DualQuant), \
-    DECLARE_APPLET( 45, 0x02, EnigmaJr), \
-    DECLARE_APPLET( 42, 0x11, EnvFollow), \
-    DECLARE_APPLET( 29, 0x04, GateDelay), \
-    DECLARE_APPLET( 17, 0x50, GatedVCA), \
-    DECLARE_APPLET( 16, 0x80, LoFiPCM), \
-    DECLARE_APPLET( 10, 0x44, Logic), \
-    DECLARE_APPLET( 21, 0x01, LowerRenz), \
-    DECLARE_APPLET( 50, 0x04, Metronome), \
-    DECLARE_APPLET(150, 0x20, hMIDIIn), \
-    DECLARE_APPLET( 27, 0x20, hMIDIOut), \
-    DECLARE_APPLET( 33, 0x10, MixerBal), \
-    DECLARE_APPLET( 20, 0x02, Palimpsest), \
-    DECLARE_APPLET( 44, 0x01, RunglBook), \
-    DECLARE_APPLET( 26, 0x08, ScaleDuet), \
-    DECLARE_APPLET( 40, 0x40, Schmitt), \
-    DECLARE_APPLET( 23, 0x80, Scope), \
-    DECLARE_APPLET( 14, 0x02, Sequence5), \
-    DECLARE_APPLET( 48, 0x45, ShiftGate), \
-    DECLARE_APPLET( 18, 0x02, TM), \
-    DECLARE_APPLET( 36, 0x04, Shuffle), \
-    DECLARE_APPLET(  7, 0x01, SkewedLFO), \
-    DECLARE_APPLET( 19, 0x01, Slew), \
-    DECLARE_APPLET( 46, 0x08, Squanch), \
-    DECLARE_APPLET(  3, 0x10, Switch), \
-    DECLARE_APPLET( 13, 0x40, TLNeuron), \
-    DECLARE_APPLET( 37, 0x40, Trending), \
-    DECLARE_APPLET( 11, 0x06, TrigSeq), \
-    DECLARE_APPLET( 25, 0x06, TrigSeq16), \
-    DECLARE_APPLET( 39, 0x80, Tuner), \
-    DECLARE_APPLET( 52, 0x01, VectorEG), \
-    DECLARE_APPLET( 49, 0x01, VectorLFO), \
-    DECLARE_APPLET( 53, 0x01, VectorMod), \
-    DECLARE_APPLET( 54, 0x01, VectorMorph), \
-    DECLARE_APPLET( 43, 0x10, Voltage), \
+    PROFILE_APPLET(  8, 0x01, ADSREG) \
+    PROFILE_APPLET( 34, 0x01, ADEG) \
+    PROFILE_APPLET( 15, 0x02, AnnularFusion) \
+    PROFILE_APPLET( 47, 0x09, ASR) \
+    PROFILE_APPLET( 56, 0x10, AttenuateOffset) \
+    PROFILE_APPLET( 41, 0x41, Binary) \
+    PROFILE_APPLET( 51, 0x80, BootsNCat) \
+    PROFILE_APPLET(  4, 0x14, Brancher) \
+    PROFILE_APPLET( 31, 0x04, Burst) \
+    PROFILE_APPLET( 12, 0x10, Calculate) \
+    PROFILE_APPLET( 32, 0x0a, Carpeggio) \
+    PROFILE_APPLET(  6, 0x04, ClockDivider) \
+    PROFILE_APPLET( 28, 0x04, ClockSkip) \
+    PROFILE_APPLET( 30, 0x10, Compare) \
+    PROFILE_APPLET( 24, 0x02, CVRecV2) \
+    PROFILE_APPLET( 55, 0x80, DrCrusher) \
+    PROFILE_APPLET(  9, 0x08, DualQuant) \
+    PROFILE_APPLET( 45, 0x02, EnigmaJr) \
+    PROFILE_APPLET( 42, 0x11, EnvFollow) \
+    PROFILE_APPLET( 29, 0x04, GateDelay) \
+    PROFILE_APPLET( 17, 0x50, GatedVCA) \
+    PROFILE_APPLET( 16, 0x80, LoFiPCM) \
+    PROFILE_APPLET( 10, 0x44, Logic) \
+    PROFILE_APPLET( 21, 0x01, LowerRenz) \
+    PROFILE_APPLET( 50, 0x04, Metronome) \
+    PROFILE_APPLET(150, 0x20, hMIDIIn) \
+    PROFILE_APPLET( 27, 0x20, hMIDIOut) \
+    PROFILE_APPLET( 33, 0x10, MixerBal) \
+    PROFILE_APPLET( 20, 0x02, Palimpsest) \
+    PROFILE_APPLET( 44, 0x01, RunglBook) \
+    PROFILE_APPLET( 26, 0x08, ScaleDuet) \
+    PROFILE_APPLET( 40, 0x40, Schmitt) \
+    PROFILE_APPLET( 23, 0x80, Scope) \
+    PROFILE_APPLET( 14, 0x02, Sequence5) \
+    PROFILE_APPLET( 48, 0x45, ShiftGate) \
+    PROFILE_APPLET( 18, 0x02, TM) \
+    PROFILE_APPLET( 36, 0x04, Shuffle) \
+    PROFILE_APPLET(  7, 0x01, SkewedLFO) \
+    PROFILE_APPLET( 19, 0x01, Slew) \
+    PROFILE_APPLET( 46, 0x08, Squanch) \
+    PROFILE_APPLET(  3, 0x10, Switch) \
+    PROFILE_APPLET( 13, 0x40, TLNeuron) \
+    PROFILE_APPLET( 37, 0x40, Trending) \
+    PROFILE_APPLET( 11, 0x06, TrigSeq) \
+    PROFILE_APPLET( 25, 0x06, TrigSeq16) \
+    PROFILE_APPLET( 39, 0x80, Tuner) \
+    PROFILE_APPLET( 52, 0x01, VectorEG) \
+    PROFILE_APPLET( 49, 0x01, VectorLFO) \
+    PROFILE_APPLET( 53, 0x01, VectorMod) \
+    PROFILE_APPLET( 54, 0x01, VectorMorph) \
+    PROFILE_APPLET( 43, 0x10, Voltage) \
 }
 /*    DECLARE_APPLET(127, 0x80, DIAGNOSTIC), \ */
+
+// Applets that follow their CV inputs at audio-ish rates get more ADC scan
+// slots for those inputs, see HemisphereManager::UpdateScanSchedule().
+// { id, input mask (bit 0 = CV1, bit 1 = CV2) }
+#define HEMISPHERE_FAST_INPUT_WEIGHT 4
+#define HEMISPHERE_FAST_INPUTS { \
+    {  9, 0x03 }, /* DualQuant */ \
+    { 16, 0x01 }, /* LoFiPCM */ \
+    { 23, 0x03 }, /* Scope */ \
+    { 42, 0x03 }, /* EnvFollow */ \
+}
@@ -41,7 +41,6 @@
 #include "src/drivers/ADC/OC_util_ADC.h"
 #include "util/util_debugpins.h"
 
-unsigned long LAST_REDRAW_TIME = 0;
 uint_fast8_t MENU_REDRAW = true;
 OC::UiMode ui_mode = OC::UI_MODE_MENU;
 const bool DUMMY = false;
@@ -75,10 +74,13 @@ void FASTRUN CORE_timer_ISR() {
 
   // The ADC scan uses async startSingleRead/readSingle and single channel each
   // loop, so should be fast enough even at 60us (check ADC::busy_waits() == 0)
-  // to verify. Effectively, the scan rate is ISR / 4 / ADC::kAdcSmoothing
+  // to verify. Effectively, the scan rate is ISR / 4 / (1 << ADC::kAdcSmoothShift)
+  // with the default filter profile:
   // 100us: 10kHz / 4 / 4 ~ .6kHz
   // 60us: 16.666K / 4 / 4 ~ 1kHz
-  // kAdcSmoothing == 4 has some (maybe 1-2LSB) jitter but seems "Good Enough".
+  // kAdcSmoothShift == 2 has some (maybe 1-2LSB) jitter but seems "Good Enough".
+  // With ADC_DMA_SCAN the conversions run continuously and all channels are
+  // updated each ISR, i.e. ~2kHz at 60us with the same noise level.
   OC::ADC::Scan();
 
   // Pin changes are tracked in separate ISRs, so depending on prio it might
@@ -105,6 +107,7 @@ void setup() {
   SPI_init();
   SERIAL_PRINTLN("* O&C BOOTING...");
   SERIAL_PRINTLN("* %s", OC_VERSION);
+  SERIAL_PRINTLN("* Profile: %s", OC_BUILD_PROFILE);
 
   OC::DEBUG::Init();
   OC::DigitalInputs::Init();
@@ -113,6 +116,7 @@ void setup() {
   OC::DAC::Init(&OC::calibration_data.dac);
 
   display::Init();
+  display::governor.Init(OC_DISPLAY_FPS, OC_DISPLAY_MAX_ISR_LOAD);
 
   GRAPHICS_BEGIN_FRAME(true);
   GRAPHICS_END_FRAME();
@@ -151,10 +155,16 @@ void setup() {
 
 /*  ---------    main loop  --------  */
 
+// Average core ISR time in % of the ISR period
+static inline uint32_t isr_load() {
+  return (OC::DEBUG::ISR_cycles.value() * 100) / (F_CPU / OC_CORE_ISR_FREQ);
+}
+
 void FASTRUN loop() {
 
   OC::CORE::app_isr_enabled = true;
   uint32_t menu_redraws = 0;
+  bool blanked = false; // Blank frame written since the screensaver started
   while (true) {
 
     // don't change current_app while it's running
@@ -165,6 +175,14 @@ void FASTRUN loop() {
 
     // Refresh display
     if (MENU_REDRAW) {
+      display::governor.Wake();
+      MENU_REDRAW = 0;
+    }
+    if (blanked && !display::driver.suspended() && !display::frame_buffer.readable()) {
+      // The blank screen has been sent, no need for further transfers until wake
+      display::driver.Suspend();
+    }
+    if (!display::driver.suspended() && display::governor.Due(micros(), isr_load())) {
       GRAPHICS_BEGIN_FRAME(false); // Don't busy wait
         if (OC::UI_MODE_MENU == ui_mode) {
           OC_DEBUG_RESET_CYCLES(menu_redraws, 512, OC::DEBUG::MENU_draw_cycles);
@@ -174,9 +192,9 @@ void FASTRUN loop() {
         } else {
           //Blank the screen instead of drawing the screensaver (chysn 9/2/2018)
           //OC::apps::current_app->DrawScreensaver();
+          blanked = true;
         }
-        MENU_REDRAW = 0;
-        LAST_REDRAW_TIME = millis();
+        display::governor.Drawn(micros());
       GRAPHICS_END_FRAME();
     }
 
@@ -188,15 +206,17 @@ void FASTRUN loop() {
 
     // State transition for app
     if (mode != ui_mode) {
-      if (OC::UI_MODE_SCREENSAVER == mode)
+      if (OC::UI_MODE_SCREENSAVER == mode) {
         OC::apps::current_app->HandleAppEvent(OC::APP_EVENT_SCREENSAVER_ON);
-      else if (OC::UI_MODE_SCREENSAVER == ui_mode)
+      } else if (OC::UI_MODE_SCREENSAVER == ui_mode) {
         OC::apps::current_app->HandleAppEvent(OC::APP_EVENT_SCREENSAVER_OFF);
+        // Wake with a full refresh of the next frame
+        blanked = false;
+        display::driver.Resume();
+        display::governor.Wake();
+      }
       ui_mode = mode;
     }
-
-    if (millis() - LAST_REDRAW_TIME > REDRAW_TIMEOUT_MS)
-      MENU_REDRAW = 1;
   }
 }
 
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# Build profiles: select which apps and Hemisphere applets are compiled into
+# the firmware.
+#
+# Run from source directory, e.g.
+#   ./resources/build_profile.py resources/profiles/rack.txt
+# to (re-)generate OC_build_profile.h, or
+#   ./resources/build_profile.py --report path/to/o_c_REV.ino.elf
+# to get a flash/RAM footprint breakdown for a compiled image.
+#
+# A profile is a plain list file with an [apps] and an [applets] section. Apps
+# are named by their DECLARE_APP prefix in OC_apps.ino, applets by their class
+# name in hemisphere_config.h. '*' selects everything in a section, and '#'
+# starts a comment.
+#
+# The lists of available apps/applets are taken from OC_apps.ino and
+# hemisphere_config.h, so those remain the only places to register new ones.
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+PROFILE_HEADER = 'OC_build_profile.h'
+
+def available_apps():
+    with open('OC_apps.ino') as f:
+        return re.findall(r'^\s*DECLARE_APP\([^)]*,\s*(\w+)\)', f.read(), re.M)
+
+def available_applets():
+    with open('hemisphere_config.h') as f:
+        return re.findall(r'^\s*PROFILE_APPLET\(\s*\d+,\s*\w+,\s*(\w+)\)', f.read(), re.M)
+
+def parse_profile(path):
+    sections = {'apps': [], 'applets': []}
+    section = None
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            m = re.match(r'^\[(\w+)\]$', line)
+            if m:
+                section = m.group(1)
+                if section not in sections:
+                    sys.exit('%s:%d: Unknown section [%s]' % (path, lineno, section))
+            elif section is None:
+                sys.exit('%s:%d: Entry outside of [apps] or [applets]' % (path, lineno))
+            else:
+                sections[section].append(line)
+    return sections
+
+def select(requested, available, what, path):
+    if '*' in requested:
+        return list(available)
+    for name in requested:
+        if name not in available:
+            sys.exit('%s: Unknown %s "%s", available are: %s' % (path, what, name, ' '.join(available)))
+    return [name for name in available if name in requested]
+
+def generate(path):
+    apps = available_apps()
+    applets = available_applets()
+    sections = parse_profile(path)
+
+    enabled_apps = select(sections['apps'], apps, 'app', path)
+    enabled_applets = select(sections['applets'], applets, 'applet', path)
+    if not enabled_apps:
+        sys.exit('%s: At least one app is required' % path)
+    if 'HEMISPHERE' not in enabled_apps:
+        enabled_applets = []
+    elif not enabled_applets:
+        sys.exit('%s: Hemisphere needs at least one applet' % path)
+
+    name = os.path.splitext(os.path.basename(path))[0]
+    lines = [
+        '#ifndef OC_BUILD_PROFILE_H_',
+        '#define OC_BUILD_PROFILE_H_',
+        '//',
+        '// GENERATED FILE, DO NOT EDIT',
+        '// ./resources/build_profile.py %s' % path,
+        '//',
+        '#define OC_BUILD_PROFILE "%s"' % name,
+        '',
+        '// Apps (OC_apps.ino)',
+    ]
+    lines += ['#define ENABLE_APP_%s %d' % (app, app in enabled_apps) for app in apps]
+    lines += ['', '// Hemisphere applets (hemisphere_config.h)']
+    lines += ['#define ENABLE_APPLET_%s %d' % (applet, applet in enabled_applets) for applet in applets]
+    lines += [
+        '',
+        '#define HEMISPHERE_PROFILE_APPLET_COUNT %d' % len(enabled_applets),
+        '',
+        '#endif // OC_BUILD_PROFILE_H_',
+    ]
+    with open(PROFILE_HEADER, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+    print('%s: profile "%s", %d/%d apps, %d/%d applets' % (
+        PROFILE_HEADER, name, len(enabled_apps), len(apps), len(enabled_applets), len(applets)))
+
+def report(elf, nm):
+    # Attribute symbols to apps/applets by name: applets use <Class>::... and
+    # <Class>_... (instances and thunks), apps use their DECLARE_APP prefix.
+    owners = [(applet, 'applet') for applet in available_applets()] + [('ClockSetup', 'applet')]
+    owners += [(app, 'app') for app in available_apps()]
+    patterns = [(re.compile(r'^(%s::|%s_)' % (o, o)), o, kind) for o, kind in owners]
+
+    output = subprocess.check_output([nm, '-S', '-C', '--size-sort', elf], universal_newlines=True)
+    totals = {}
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) < 4:
+            continue
+        size, symbol_type, symbol = int(fields[1], 16), fields[2].lower(), fields[3]
+        region = 'flash' if symbol_type in 'trw' else 'ram'
+        if symbol_type == 'd':
+            region = 'both' # .data lives in flash and is copied to RAM
+        owner = ('(core)', '')
+        for pattern, name, kind in patterns:
+            if pattern.match(symbol):
+                owner = (name, kind)
+                break
+        entry = totals.setdefault(owner, {'flash': 0, 'ram': 0})
+        if region in ('flash', 'both'):
+            entry['flash'] += size
+        if region in ('ram', 'both'):
+            entry['ram'] += size
+
+    print('%-24s %-7s %8s %8s' % ('name', 'kind', 'flash', 'ram'))
+    for (name, kind), entry in sorted(totals.items(), key=lambda x: -x[1]['flash']):
+        print('%-24s %-7s %8d %8d' % (name, kind, entry['flash'], entry['ram']))
+    print('%-24s %-7s %8d %8d' % ('total', '',
+        sum(e['flash'] for e in totals.values()), sum(e['ram'] for e in totals.values())))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='O&C build profiles')
+    parser.add_argument('profile', nargs='?', help='profile list file')
+    parser.add_argument('--report', metavar='ELF', help='print footprint of compiled image')
+    parser.add_argument('--nm', default='arm-none-eabi-nm', help='nm to use for --report')
+    args = parser.parse_args()
+
+    if args.report:
+        report(args.report, args.nm)
+    elif args.profile:
+        generate(args.profile)
+    else:
+        parser.print_help()
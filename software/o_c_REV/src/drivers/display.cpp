@@ -27,8 +27,9 @@ weegfx::Graphics graphics;
 
 namespace display {
 
-FrameBuffer<SH1106_128x64_Driver::kFrameSize, 2> frame_buffer;
+FrameBuffer<SH1106_128x64_Driver::kFrameSize, kNumFrames, SH1106_128x64_Driver::kNumPages> frame_buffer;
 PagedDisplayDriver<SH1106_128x64_Driver> driver;
+util::FrameGovernor governor;
 
 void Init() {
   frame_buffer.Init();
@@ -38,6 +39,7 @@ void Init() {
 
 void AdjustOffset(uint8_t offset) {
 	SH1106_128x64_Driver::AdjustOffset(offset);
+	driver.Invalidate();
 }
 
 };
@@ -23,16 +23,27 @@
 #ifndef DRIVERS_DISPLAY_H_
 #define DRIVERS_DISPLAY_H_
 
+#include "../../OC_options.h"
 #include "framebuffer.h"
 #include "page_display_driver.h"
 #include "SH1106_128x64_driver.h"
 #include "weegfx.h"
 #include "../../util/util_debugpins.h"
+#include "../../util/util_frame_governor.h"
 
 namespace display {
 
-extern FrameBuffer<SH1106_128x64_Driver::kFrameSize, 2> frame_buffer;
+#ifdef DISPLAY_SINGLE_BUFFER
+// A new frame can only be drawn once the previous one has been sent, which
+// takes kNumPages core ISRs
+static constexpr size_t kNumFrames = 1;
+#else
+static constexpr size_t kNumFrames = 2;
+#endif
+
+extern FrameBuffer<SH1106_128x64_Driver::kFrameSize, kNumFrames, SH1106_128x64_Driver::kNumPages> frame_buffer;
 extern PagedDisplayDriver<SH1106_128x64_Driver> driver;
+extern util::FrameGovernor governor;
 
 void Init();
 void AdjustOffset(uint8_t offset);
@@ -49,7 +60,7 @@ static inline void Update() {
     driver.Update();
   } else {
     if (frame_buffer.readable())
-      driver.Begin(frame_buffer.readable_frame());
+      driver.Begin(frame_buffer.readable_frame(), frame_buffer.readable_page_hashes());
   }
 }
 
@@ -71,6 +82,7 @@ do { \
 
 #define GRAPHICS_END_FRAME() \
     graphics.End(); \
+    display::driver.HashPages(frame, display::frame_buffer.writeable_page_hashes()); \
     display::frame_buffer.written(); \
   } \
 } while (0)
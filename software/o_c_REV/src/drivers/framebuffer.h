@@ -14,7 +14,9 @@
 // transferred.
 // See https://gist.github.com/patrickdowling/0029f58fb20e63d7db9d
 
-template <size_t frame_size, size_t frames>
+// Each frame also has a hash per page, so the display driver can skip pages
+// that haven't changed.
+template <size_t frame_size, size_t frames, size_t pages>
 class FrameBuffer {
 public:
 
@@ -26,6 +28,7 @@ public:
     memset(frame_memory_, 0, sizeof(frame_memory_));
     for (size_t f = 0; f < frames; ++f)
       frame_buffers_[f] = frame_memory_ + kFrameSize * f;
+    memset(page_hashes_, 0, sizeof(page_hashes_));
     write_ptr_ = read_ptr_ = 0;
   }
 
@@ -47,6 +50,25 @@ public:
     return frame_buffers_[write_ptr_ % frames];
   }
 
+  const uint32_t *readable_page_hashes() const {
+    return page_hashes_[read_ptr_ % frames];
+  }
+
+  uint32_t *writeable_page_hashes() {
+    return page_hashes_[write_ptr_ % frames];
+  }
+
+  // @return most recently written frame (assumes one exists)
+  const uint8_t *last_written_frame() const {
+    return frame_buffers_[(write_ptr_ - 1) % frames];
+  }
+
+  // @return number of frames written so far, e.g. to check if the last written
+  // frame is the one expected
+  size_t frames_written() const {
+    return write_ptr_;
+  }
+
   void read() {
     ++read_ptr_;
   }
@@ -59,6 +81,7 @@ private:
 
   uint8_t frame_memory_[kFrameSize * frames] __attribute__ ((aligned (4)));
   uint8_t *frame_buffers_[frames];
+  uint32_t page_hashes_[frames][pages];
 
   volatile size_t write_ptr_;
   volatile size_t read_ptr_;
@@ -7,38 +7,109 @@
 // In theory parts of the transfer may be done via DMA and the page memory
 // will have to be valid until that completes, so the ::Flush call is used
 // to determine if cleanup is necessary.
+//
+// Pages whose hash matches the one last sent are skipped. The hashes are
+// calculated when the frame is finished (see GRAPHICS_END_FRAME) so the ISR
+// only has to compare them.
 template <typename display_driver>
 class PagedDisplayDriver {
 public:
+  static constexpr size_t kNumPages = display_driver::kNumPages;
+  static constexpr size_t kPageSize = display_driver::kPageSize;
+  static constexpr uint32_t kStatsWindow = 512; // pages
 
   PagedDisplayDriver() { }
 
   void Init() {
 
     display_driver::Init();
-
     current_page_index_ = 0;
     current_page_data_ = NULL;
+    dirty_pages_ = 0;
+    flush_pending_ = true;
+    suspended_ = false;
+    Invalidate();
+    pages_ = pages_skipped_ = 0;
+    skipped_pages_percent_ = 0;
+    pages_sent_ = 0;
+    suspended_ticks_ = 0;
+  }
+
+  // Send all pages of the next frame, e.g. if the display contents were lost
+  void Invalidate() {
+    display_valid_ = false;
+  }
+
+  // While suspended (e.g. the screen is blanked) frames are consumed without
+  // sending anything. The first frame after Resume is sent completely.
+  void Suspend() {
+    suspended_ = true;
+  }
+
+  void Resume() {
+    Invalidate();
+    suspended_ = false;
   }
 
-  void Begin(const uint8_t *frame) {
+  bool suspended() const {
+    return suspended_;
+  }
+
+  // @param frame 32-bit aligned frame data
+  // @param hashes [out] hash for each page
+  static void HashPages(const uint8_t *frame, uint32_t *hashes) {
+    const uint32_t *data = reinterpret_cast<const uint32_t *>(frame);
+    for (size_t p = 0; p < kNumPages; ++p) {
+      uint32_t hash = 0x811c9dc5; // FNV-1a, but per word
+      for (size_t i = 0; i < kPageSize / 4; ++i)
+        hash = (hash ^ *data++) * 0x01000193;
+      hashes[p] = hash;
+    }
+  }
+
+  void Begin(const uint8_t *frame, const uint32_t *page_hashes) {
+    uint32_t dirty = 0;
+    if (!suspended_) {
+      for (size_t p = 0; p < kNumPages; ++p) {
+        if (!display_valid_ || page_hashes[p] != display_hashes_[p])
+          dirty |= 0x1 << p;
+        display_hashes_[p] = page_hashes[p];
+      }
+      display_valid_ = true;
+
+      pages_ += kNumPages;
+      pages_skipped_ += kNumPages - __builtin_popcount(dirty);
+      if (pages_ >= kStatsWindow) {
+        skipped_pages_percent_ = (pages_skipped_ * 100) / pages_;
+        pages_ = pages_skipped_ = 0;
+      }
+    }
+
+    dirty_pages_ = dirty;
     current_page_data_ = frame;
-    current_page_index_ = 0;
+    current_page_index_ = next_dirty_page();
   }
 
   void Update() {
     uint_fast8_t page = current_page_index_;
-    if (page < display_driver::kNumPages) {
-      const uint8_t *data = current_page_data_;
-      display_driver::SendPage(page, data);
-      current_page_index_ = page + 1;
-      current_page_data_ = data + display_driver::kPageSize;
+    if (page < kNumPages) {
+      display_driver::SendPage(page, current_page_data_ + page * kPageSize);
+      flush_pending_ = true;
+      ++pages_sent_;
+      dirty_pages_ &= ~(0x1 << page);
+      current_page_index_ = next_dirty_page();
     }
   }
 
+  // Finishes the page transfer started in the previous Update, if any
   bool Flush() {
-    display_driver::Flush();
-    if (current_page_index_ < display_driver::kNumPages) {
+    if (flush_pending_) {
+      display_driver::Flush();
+      flush_pending_ = false;
+    }
+    if (suspended_)
+      ++suspended_ticks_;
+    if (current_page_index_ < kNumPages) {
       return false;
     } else {
       current_page_index_ = 0;
@@ -51,9 +122,39 @@ public:
     return NULL != current_page_data_;
   }
 
+  // Percentage of unchanged pages that weren't sent in the last stats window
+  uint32_t skipped_pages_percent() const {
+    return skipped_pages_percent_;
+  }
+
+  uint32_t pages_sent() const {
+    return pages_sent_;
+  }
+
+  // Number of Flush calls (i.e. ISRs) while suspended
+  uint32_t suspended_ticks() const {
+    return suspended_ticks_;
+  }
+
 private:
   uint_fast8_t current_page_index_;
   const uint8_t *current_page_data_;
+  uint32_t dirty_pages_;
+  bool flush_pending_;
+  volatile bool suspended_;
+
+  uint32_t display_hashes_[kNumPages];
+  volatile bool display_valid_;
+
+  uint32_t pages_;
+  uint32_t pages_skipped_;
+  uint32_t skipped_pages_percent_;
+  uint32_t pages_sent_;
+  uint32_t suspended_ticks_;
+
+  uint_fast8_t next_dirty_page() const {
+    return dirty_pages_ ? __builtin_ctz(dirty_pages_) : kNumPages;
+  }
 
   DISALLOW_COPY_AND_ASSIGN(PagedDisplayDriver);
 };
@@ -18,7 +18,12 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#else // host build for tests
+#include <stdio.h>
+#define PROGMEM
+#endif
 #include <string.h>
 #include <stdarg.h>
 
@@ -45,7 +50,7 @@ const uint8_t test_bitmap[8] = {
 // - Bench templated draw_pixel_row (inlined versions) vs. function pointers
 // - Offer specialized functions w/o clipping or specific draw mode?
 // - Remainder masks as LUT or switch
-// - 32bit ops? Should be possible along x-axis (use SIMD instructions?) but not y (page stride)
+// - 32bit ops are only along x-axis (see load32/store32), not y (page stride)
 // - Clipping for x, y < 0
 // - Support 16 bit text characters?
 // - Kerning/BBX etc.
@@ -70,8 +75,49 @@ inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, uint8_t mask) __
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, const uint8_t *src) __attribute__((always_inline));
 
+// Four adjacent columns of a page as one word; memcpy avoids aliasing issues.
+// Callers have to make sure the address is word aligned: the M4 allows most
+// unaligned LDR/STR, but one that straddles the SRAM_L/SRAM_U boundary faults.
+static inline uint32_t load32(const uint8_t *src) __attribute__((always_inline));
+static inline uint32_t load32(const uint8_t *src) {
+  uint32_t word;
+  memcpy(&word, src, sizeof(word));
+  return word;
+}
+
+static inline void store32(uint8_t *dst, uint32_t word) __attribute__((always_inline));
+static inline void store32(uint8_t *dst, uint32_t word) {
+  memcpy(dst, &word, sizeof(word));
+}
+
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, uint8_t mask) {
+  // Longer rows are worth aligning so the bulk can be done four columns at a time
+  if (draw_mode != weegfx::DRAW_DOT && count >= 8) {
+    while (reinterpret_cast<uintptr_t>(dst) & 0x3) {
+      switch (draw_mode) {
+        case weegfx::DRAW_NORMAL: *dst++ |= mask; break;
+        case weegfx::DRAW_INVERSE: *dst++ ^= mask; break;
+        case weegfx::DRAW_OVERWRITE: *dst++ = mask; break;
+        case weegfx::DRAW_CLEAR: *dst++ &= ~mask; break;
+        case weegfx::DRAW_DOT: break;
+      }
+      --count;
+    }
+    const uint32_t mask32 = mask * 0x01010101U;
+    while (count >= 4) {
+      switch (draw_mode) {
+        case weegfx::DRAW_NORMAL: store32(dst, load32(dst) | mask32); break;
+        case weegfx::DRAW_INVERSE: store32(dst, load32(dst) ^ mask32); break;
+        case weegfx::DRAW_OVERWRITE: store32(dst, mask32); break;
+        case weegfx::DRAW_CLEAR: store32(dst, load32(dst) & ~mask32); break;
+        case weegfx::DRAW_DOT: break;
+      }
+      dst += 4;
+      count -= 4;
+    }
+  }
+
   while (count-- > 0x0) {
     switch (draw_mode) {
       case weegfx::DRAW_NORMAL: *dst++ |= mask; break;
@@ -94,22 +140,102 @@ inline void draw_pixel_row(uint8_t *dst, weegfx::coord_t count, const uint8_t *s
   }
 }
 
+// Set pixels from 8-pixel high bitmap columns, shifted down by 0-7 pixels
+// (i.e. the bits that would be in the page below are lost). Within a word the
+// bytes are shifted together and the bits that would cross into the next
+// column are masked.
 // It's tempting to check if the pixel is != 0, but first measurement shows it
 // actually makes things worse...
-#define SETPIXELS_H(start, count, value) \
-do { \
-  uint8_t *ptr = start; \
-  size_t n = count; \
-  while (n--) { \
-    *ptr++ |= value; \
-  }; \
-} while (0)
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixels(uint8_t *dst, uint8_t bits) __attribute__((always_inline));
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixels(uint8_t *dst, uint8_t bits) {
+  switch (draw_mode) {
+    case weegfx::DRAW_INVERSE: *dst ^= bits; break;
+    default: *dst |= bits; break;
+  }
+}
+
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixels(uint8_t *dst, uint32_t bits) __attribute__((always_inline));
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixels(uint8_t *dst, uint32_t bits) {
+  switch (draw_mode) {
+    case weegfx::DRAW_INVERSE: store32(dst, load32(dst) ^ bits); break;
+    default: store32(dst, load32(dst) | bits); break;
+  }
+}
+
+// @return number of leading columns to blit bytewise before dst and src are
+// both word aligned; that's the whole row if they can't be aligned together
+// or it's too short to be worth it.
+static inline weegfx::coord_t aligned_lead(const uint8_t *dst, const uint8_t *src, weegfx::coord_t count) __attribute__((always_inline));
+static inline weegfx::coord_t aligned_lead(const uint8_t *dst, const uint8_t *src, weegfx::coord_t count) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(dst);
+  if (count < 8 || ((address ^ reinterpret_cast<uintptr_t>(src)) & 0x3))
+    return count;
+  return (0x4 - (address & 0x3)) & 0x3;
+}
+
+// Set pixels from bitmap columns that are already shifted to the page
+inline void blit_pixel_row(uint8_t *dst, const uint8_t *src, weegfx::coord_t count) __attribute__((always_inline));
+inline void blit_pixel_row(uint8_t *dst, const uint8_t *src, weegfx::coord_t count) {
+  weegfx::coord_t lead = aligned_lead(dst, src, count);
+  count -= lead;
+  while (lead--)
+    blit_pixels<weegfx::DRAW_NORMAL>(dst++, *src++);
+  while (count >= 4) {
+    blit_pixels<weegfx::DRAW_NORMAL>(dst, load32(src));
+    dst += 4; src += 4;
+    count -= 4;
+  }
+  while (count--)
+    blit_pixels<weegfx::DRAW_NORMAL>(dst++, *src++);
+}
+
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixel_row_down(uint8_t *dst, const uint8_t *src, weegfx::coord_t count, weegfx::coord_t shift) __attribute__((always_inline));
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixel_row_down(uint8_t *dst, const uint8_t *src, weegfx::coord_t count, weegfx::coord_t shift) {
+  weegfx::coord_t lead = aligned_lead(dst, src, count);
+  count -= lead;
+  while (lead--)
+    blit_pixels<draw_mode>(dst++, static_cast<uint8_t>((*src++) << shift));
+  const uint32_t mask32 = static_cast<uint8_t>(0xff << shift) * 0x01010101U;
+  while (count >= 4) {
+    blit_pixels<draw_mode>(dst, (load32(src) << shift) & mask32);
+    dst += 4; src += 4;
+    count -= 4;
+  }
+  while (count--)
+    blit_pixels<draw_mode>(dst++, static_cast<uint8_t>((*src++) << shift));
+}
+
+// Bits shifted out of the page above by blit_pixel_row_down, shift = 1-7
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixel_row_up(uint8_t *dst, const uint8_t *src, weegfx::coord_t count, weegfx::coord_t shift) __attribute__((always_inline));
+template <weegfx::DRAW_MODE draw_mode>
+inline void blit_pixel_row_up(uint8_t *dst, const uint8_t *src, weegfx::coord_t count, weegfx::coord_t shift) {
+  weegfx::coord_t lead = aligned_lead(dst, src, count);
+  count -= lead;
+  while (lead--)
+    blit_pixels<draw_mode>(dst++, static_cast<uint8_t>((*src++) >> (8 - shift)));
+  const uint32_t mask32 = (0xff >> (8 - shift)) * 0x01010101U;
+  while (count >= 4) {
+    blit_pixels<draw_mode>(dst, (load32(src) >> (8 - shift)) & mask32);
+    dst += 4; src += 4;
+    count -= 4;
+  }
+  while (count--)
+    blit_pixels<draw_mode>(dst++, static_cast<uint8_t>((*src++) >> (8 - shift)));
+}
 
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_rect(uint8_t *buf, weegfx::coord_t y, weegfx::coord_t w, weegfx::coord_t h) __attribute__((always_inline)); 
 
 void Graphics::Init() {
   frame_ = NULL;
+  layer_ = NULL;
   setPrintPos(0, 0);
 }
 
@@ -126,6 +252,29 @@ void Graphics::End() {
   frame_ = NULL;
 }
 
+void Graphics::BeginLayer(Layer &layer, const void *owner, uint32_t key) {
+  layer_frame_ = frame_;
+  layer_ = &layer;
+  layer_text_x_ = text_x_;
+  layer_text_y_ = text_y_;
+  layer.valid_ = false;
+  layer.owner_ = owner;
+  layer.key_ = key;
+  frame_ = layer.data_;
+  memset(frame_, 0, kFrameSize);
+}
+
+void Graphics::EndLayer() {
+  frame_ = layer_frame_;
+  layer_->valid_ = true;
+  layer_ = NULL;
+  setPrintPos(layer_text_x_, layer_text_y_);
+}
+
+void Graphics::drawLayer(const Layer &layer) {
+  memcpy(frame_, layer.data_, kFrameSize);
+}
+
 template <weegfx::DRAW_MODE draw_mode>
 inline void draw_rect(uint8_t *buf, weegfx::coord_t y, weegfx::coord_t w, weegfx::coord_t h)
 {
@@ -281,8 +430,9 @@ void Graphics::drawBitmap8(coord_t x, coord_t y, coord_t w, const uint8_t *data)
 
   if (x + w > kWidth) w = kWidth - x;
   if (x < 0) {
-    data += x;
+    data -= x;
     w += x;
+    x = 0;
   }
   if (w <= 0)
     return;
@@ -293,17 +443,40 @@ void Graphics::drawBitmap8(coord_t x, coord_t y, coord_t w, const uint8_t *data)
   uint8_t *buf = get_frame_ptr(x, y);
 
   coord_t remainder = y & 0x7;
-  if (!remainder) {
-    SETPIXELS_H(buf, w, *data++);
-  } else {
-    const uint8_t *src = data;
-    SETPIXELS_H(buf, w, (*src++) << remainder);
-    if (h >= 8) {
-      buf += kWidth;
-      src = data;
-      SETPIXELS_H(buf, w, (*src++) >> (8 - remainder));
-    }
+  blit_pixel_row_down<DRAW_NORMAL>(buf, data, w, remainder);
+  if (remainder && h >= 8)
+    blit_pixel_row_up<DRAW_NORMAL>(buf + kWidth, data, w, remainder);
+}
+
+// down and up are the rows for the shift of y, each row is width columns. As
+// in drawBitmap8, y < 0 is clipped without shifting the bitmap up.
+void Graphics::draw_preshifted_bitmap8(coord_t x, coord_t y, coord_t width, const uint8_t *down, const uint8_t *up) {
+
+  coord_t w = width;
+  if (x + w > kWidth) w = kWidth - x;
+  if (x < 0) {
+    down -= x;
+    up -= x;
+    w += x;
+    x = 0;
   }
+  if (w <= 0)
+    return;
+
+  coord_t h = 8;
+  CLIPY(y, h);
+
+  uint8_t *buf = get_frame_ptr(x, y);
+  coord_t shift = y & 0x7;
+  blit_pixel_row(buf, down, w);
+  if (shift && h >= 8)
+    blit_pixel_row(buf + kWidth, up, w);
+}
+
+void Graphics::copyColumns(const uint8_t *src_frame, coord_t x, coord_t w) {
+  CLIPX(x, w);
+  for (coord_t offset = x; offset < static_cast<coord_t>(kFrameSize); offset += kWidth)
+    memcpy(frame_ + offset, src_frame + offset, w);
 }
 
 void Graphics::drawLine(coord_t x0, coord_t y0, coord_t x1, coord_t y1) {
@@ -395,38 +568,76 @@ static inline weegfx::font_glyph get_char_glyph(char c) {
   return ssd1306xled_font6x8 + Graphics::kFixedFontW * (c - 32);
 }
 
-// OPTIMIZE When printing strings, all chars will have the same y/remainder
-// This will probably only save a few cycles, if any. Also the clipping can
-// be made optional (template?)
-void Graphics::draw_char(char c, coord_t x, coord_t y) {
+// Glyph at a page-aligned y only touches one page, so the columns can go
+// straight into the frame. Unless clipped, the loop has a fixed count and is
+// unrolled.
+template <weegfx::DRAW_MODE draw_mode, bool clip>
+inline void draw_char_aligned(uint8_t *frame, weegfx::font_glyph data, weegfx::coord_t x, weegfx::coord_t y) __attribute__((always_inline));
+template <weegfx::DRAW_MODE draw_mode, bool clip>
+inline void draw_char_aligned(uint8_t *frame, weegfx::font_glyph data, weegfx::coord_t x, weegfx::coord_t y) {
+  weegfx::coord_t w = Graphics::kFixedFontW;
+  if (clip) {
+    if (x + w > Graphics::kWidth) w = Graphics::kWidth - x;
+    if (x < 0) {
+      w += x;
+      data -= x;
+      x = 0;
+    }
+    if (w <= 0) return;
+  }
+
+  uint8_t *dst = frame + ((y >> 3) << 7) + x;
+  if (clip) {
+    while (w--)
+      blit_pixels<draw_mode>(dst++, *data++);
+  } else {
+    for (weegfx::coord_t i = 0; i < Graphics::kFixedFontW; ++i)
+      blit_pixels<draw_mode>(dst + i, data[i]);
+  }
+}
+
+template <weegfx::DRAW_MODE draw_mode>
+void render_char(uint8_t *frame, char c, weegfx::coord_t x, weegfx::coord_t y) {
   if (!c) c = '0';
   if (c <= 32 || c > 127)
     return;
 
-  coord_t w = Graphics::kFixedFontW;
-  coord_t h = Graphics::kFixedFontH;
-  font_glyph data = get_char_glyph(c);
-  if (c + w > kWidth) w = kWidth - x;
+  weegfx::font_glyph data = get_char_glyph(c);
+  if (!(y & 0x7) && y >= 0 && y < Graphics::kHeight) {
+    if (x >= 0 && x <= Graphics::kWidth - Graphics::kFixedFontW)
+      draw_char_aligned<draw_mode, false>(frame, data, x, y);
+    else
+      draw_char_aligned<draw_mode, true>(frame, data, x, y);
+    return;
+  }
+
+  weegfx::coord_t w = Graphics::kFixedFontW;
+  weegfx::coord_t h = Graphics::kFixedFontH;
+  if (x + w > Graphics::kWidth) w = Graphics::kWidth - x;
   if (x < 0) {
     w += x;
-    data += x;
+    data -= x;
+    x = 0;
   }
   if (w <= 0) return;
-  CLIPY(y, h);
-
-  uint8_t *dest = get_frame_ptr(x, y);
-  coord_t remainder = y & 0x7;
-  if (!remainder) {
-    SETPIXELS_H(dest, w, *data++);
-  } else {
-    const uint8_t *src = data;
-    SETPIXELS_H(dest, w, (*src++) << remainder);
-    if (h >= 8) {
-      dest += kWidth;
-      src = data;
-      SETPIXELS_H(dest, w, (*src++) >> (8 - remainder));
-    }
+  if (y < 0) {
+    // Only the bottom rows are visible, and they all land in the first page
+    if (y > -h)
+      blit_pixel_row_up<draw_mode>(frame + x, data, w, y & 0x7);
+    return;
   }
+  if (y + h > Graphics::kHeight) h = Graphics::kHeight - y;
+  if (h <= 0) return;
+
+  uint8_t *dest = frame + ((y >> 3) << 7) + x;
+  weegfx::coord_t remainder = y & 0x7;
+  blit_pixel_row_down<draw_mode>(dest, data, w, remainder);
+  if (remainder && h >= 8)
+    blit_pixel_row_up<draw_mode>(dest + Graphics::kWidth, data, w, remainder);
+}
+
+void Graphics::draw_char(char c, coord_t x, coord_t y) {
+  render_char<DRAW_NORMAL>(frame_, c, x, y);
 }
 
 void Graphics::print(char c) {
@@ -434,84 +645,121 @@ void Graphics::print(char c) {
   text_x_ += kFixedFontW;
 }
 
-template <typename type, bool pretty>
-char *itos(type value, char *buf, size_t buflen) {
-  char *pos = buf + buflen;
-  *--pos = '\0';
-  if (!value) {
-    *--pos = '0';
-    if (pretty) // avoid jump when 0 -> +1 or -1
-      *--pos = ' ';
-  } else {
-    char sign = 0;
-    if (value < 0)  {
-      sign = '-';
-      value = -value;
-    } else if (pretty) {
-      sign = '+';
-    }
+// Numbers are drawn directly: the number of digits is counted first, then the
+// digits are drawn right-to-left as they are generated, so there's no need for
+// an intermediate string.
+static const char kDigits[] = "0123456789ABCDEF";
+static const int32_t kPow10[] = { 1, 10, 100, 1000, 10000, 100000 };
 
-    while (value) {
-      *--pos = '0' + value % 10;
-      value /= 10;
-    }
-    if (sign)
-      *--pos = sign;
+static inline unsigned count_digits(uint32_t value, uint32_t base) {
+  unsigned digits = 1;
+  while (value >= base) {
+    value /= base;
+    ++digits;
+  }
+  return digits;
+}
+
+// Draw digits of value right-aligned so the last one ends at x, including
+// leading zeros.
+void Graphics::draw_digits_right(uint32_t value, coord_t x, coord_t y, unsigned digits, uint32_t base) {
+  while (digits--) {
+    x -= kFixedFontW;
+    draw_char(kDigits[value % base], x, y);
+    value /= base;
+  }
+}
+
+// Print number at current print pos, padded on the left to width characters
+// (including sign) and with at least min_digits digits.
+void Graphics::print_integer(uint32_t value, char sign, unsigned width, unsigned min_digits, uint32_t base) {
+  unsigned digits = count_digits(value, base);
+  if (digits < min_digits) digits = min_digits;
+  const unsigned length = digits + (sign ? 1 : 0);
+
+  coord_t x = text_x_;
+  if (width > length)
+    x += (width - length) * kFixedFontW;
+  if (sign) {
+    draw_char(sign, x, text_y_);
+    x += kFixedFontW;
   }
+  x += digits * kFixedFontW;
+  draw_digits_right(value, x, text_y_, digits, base);
+  text_x_ = x;
+}
+
+static inline uint32_t magnitude(int32_t value) {
+  return value < 0 ? -static_cast<uint32_t>(value) : value;
+}
 
-  return pos;
+// A zero gets a space so there's no jump when 0 -> +1 or -1
+static inline char pretty_sign(int32_t value) {
+  return value < 0 ? '-' : value ? '+' : ' ';
 }
 
 void Graphics::print(int value) {
-  char buf[12];
-  print(itos<int, false>(value, buf, sizeof(buf)));
+  print_integer(magnitude(value), value < 0 ? '-' : 0, 0, 0, 10);
 }
 
 void Graphics::print(long value) {
-  char buf[24];
-  print(itos<long, false>(value, buf, sizeof(buf)));
+  print_integer(magnitude(value), value < 0 ? '-' : 0, 0, 0, 10);
 }
 
 void Graphics::pretty_print(int value) {
-  char buf[12];
-  print(itos<int, true>(value, buf, sizeof(buf)));
+  print_integer(magnitude(value), pretty_sign(value), 0, 0, 10);
 }
 
 void Graphics::print(int value, unsigned width) {
-  char buf[15];
-  char *str = itos<int, false>(value, buf, sizeof(buf));
-  while (str > buf &&
-         (unsigned)(str - buf) >= sizeof(buf) - width)
-    *--str = ' ';
-  print(str);
+  print_integer(magnitude(value), value < 0 ? '-' : 0, width, 0, 10);
 }
 
 void Graphics::print(uint16_t value, unsigned width) {
-  char buf[12];
-  char *str = itos<uint16_t, false>(value, buf, sizeof(buf));
-  while (str > buf &&
-         (unsigned)(str - buf) >= sizeof(buf) - width)
-    *--str = ' ';
-  print(str);
+  print_integer(value, 0, width, 0, 10);
 }
 
-void Graphics::print(uint32_t value, size_t width) {
-  char buf[24];
-  char *str = itos<uint32_t, false>(value, buf, sizeof(buf));
-  while (str > buf &&
-         (size_t)(str - buf) >= sizeof(buf) - width)
-    *--str = ' ';
-  print(str);
+void Graphics::print(uint32_t value, unsigned width) {
+  print_integer(value, 0, width, 0, 10);
 }
 
 void Graphics::pretty_print(int value, unsigned width) {
-  char buf[12];
-  char *str = itos<int, true>(value, buf, sizeof(buf));
+  print_integer(magnitude(value), pretty_sign(value), width, 0, 10);
+}
+
+void Graphics::print_hex(uint32_t value, unsigned digits) {
+  print_integer(value, 0, 0, digits, 16);
+}
+
+void Graphics::print_fixed(int32_t value, int32_t unit, unsigned decimals, bool plus, unsigned width) {
+  // Truncated towards zero, sign is of the truncated value. Whole and
+  // fractional parts are separate so only unit * 10^decimals has to fit.
+  const int32_t whole_part = value / unit;
+  const int32_t frac_part = (value % unit) * kPow10[decimals] / unit;
+  const uint32_t whole = magnitude(whole_part);
+  const uint32_t frac = magnitude(frac_part);
+  const char sign = (whole_part < 0 || frac_part < 0) ? '-' : plus ? '+' : 0;
+
+  const unsigned length = count_digits(whole, 10) + (sign ? 1 : 0) + (decimals ? decimals + 1 : 0);
+  if (width > length)
+    text_x_ += (width - length) * kFixedFontW;
+  print_integer(whole, sign, 0, 0, 10);
+  if (decimals) {
+    draw_char('.', text_x_, text_y_);
+    text_x_ += (decimals + 1) * kFixedFontW;
+    draw_digits_right(frac, text_x_, text_y_, decimals, 10);
+  }
+}
+
+void Graphics::print_note(int note) {
+  static const char kNoteLetters[] = "CCDDEFFGGAAB";
+  static const uint16_t kSharps = 0x54a; // C# D# F# G# A#
 
-  while (str > buf &&
-         (unsigned)(str - buf) >= sizeof(buf) - width)
-    *--str = ' ';
-  print(str);
+  int octave = note >= 0 ? note / 12 : (note - 11) / 12;
+  const int semitone = note - octave * 12;
+  print(kNoteLetters[semitone]);
+  if (kSharps & (0x1 << semitone))
+    print('#');
+  print(octave - 1);
 }
 
 void Graphics::pretty_print_right(int value) {
@@ -552,6 +800,15 @@ void Graphics::print(const char *s) {
   text_x_ = x;
 }
 
+void Graphics::print_inverse(const char *s) {
+  coord_t x = text_x_;
+  while (*s) {
+    render_char<DRAW_INVERSE>(frame_, *s++, x, text_y_);
+    x += kFixedFontW;
+  }
+  text_x_ = x;
+}
+
 void Graphics::print_right(const char *s) {
   weegfx::coord_t x = text_x_;
   weegfx::coord_t y = text_y_;
@@ -564,6 +821,7 @@ void Graphics::print_right(const char *s) {
   }
 }
 
+// Only for debugging, see print_* for typed output
 void Graphics::printf(const char *fmt, ...) {
   char buf[128];
   va_list args;
@@ -32,6 +32,9 @@ namespace weegfx {
 typedef int_fast16_t coord_t;
 typedef const uint8_t *font_glyph;
 
+class Layer;
+template <int_fast16_t width, uint8_t shifts> class PreshiftedBitmap8;
+
 // Quick & dirty graphics for 128 x 64 framebuffer with vertical pixels.
 // - Writes to provided framebuffer
 // - Interface pseudo-compatible with u8glib
@@ -51,6 +54,17 @@ public:
   void Begin(uint8_t *frame, bool clear_frame);
   void End();
 
+  // Draw into the (cleared) layer instead of the current frame until EndLayer,
+  // after which the layer is valid for owner and key, and the print pos is
+  // restored. The owner distinguishes users of a shared layer, so their keys
+  // don't need to be unique.
+  void BeginLayer(Layer &layer, const void *owner, uint32_t key);
+  void EndLayer();
+
+  // Replace frame contents with the layer, e.g. static parts of a screen
+  // instead of clearing the frame and redrawing them
+  void drawLayer(const Layer &layer);
+
   // Pseudo-compatible functions with u8lib
   void setDefaultBackgroundColor() { };
   void setDefaultForegroundColor() { };
@@ -74,6 +88,14 @@ public:
 
   void drawBitmap8(coord_t x, coord_t y, coord_t w, const uint8_t *data);
 
+  // Same as drawBitmap8 without shifting the columns when not page-aligned
+  template <coord_t width, uint8_t shifts>
+  void drawBitmap8(coord_t x, coord_t y, const PreshiftedBitmap8<width, shifts> &bitmap);
+
+  // Copy columns x to x + w - 1 (all pages) from another frame, e.g. to keep
+  // parts of the previous frame that haven't changed
+  void copyColumns(const uint8_t *src_frame, coord_t x, coord_t w);
+
   // Beware: No clipping
   void drawCircle(coord_t center_x, coord_t center_y, coord_t r);
 
@@ -96,27 +118,130 @@ public:
   // Print string at current print pos and move print pos
   void print(const char *);
 
+  // Print string at current print pos with the glyph pixels inverted instead of
+  // set (e.g. on a filled background) and move print pos
+  void print_inverse(const char *);
+
   // Print right-aligned string at current print pos; print pos is unchanged
   void print_right(const char *);
 
   // Print string at absolute coords, doesn't move print pos
   void drawStr(coord_t x, coord_t y, const char *str);
 
-  // Might be time-consuming
+  // Print hex number with leading zeros to the given number of digits
+  void print_hex(uint32_t value, unsigned digits);
+
+  // Print fixed-point value / unit with the given number of decimals, e.g.
+  // voltages (truncated towards zero). Sign is shown if negative, or always if
+  // plus is set, and the result is padded on the left to width characters.
+  // unit * 10^decimals must fit in 32 bits and decimals <= 5.
+  void print_fixed(int32_t value, int32_t unit, unsigned decimals, bool plus, unsigned width = 0);
+
+  // Print note name and octave of MIDI note number, e.g. 60 = C4, 61 = C#4
+  void print_note(int note);
+
+  // Might be time-consuming; the typed print functions should be preferred
   void printf(const char *fmt, ...);
 
   inline void drawAlignedByte(coord_t x, coord_t y, uint8_t byte) __attribute__((always_inline));
 
 private:
   uint8_t *frame_;
+  uint8_t *layer_frame_;
+  Layer *layer_;
+  coord_t layer_text_x_;
+  coord_t layer_text_y_;
 
   coord_t text_x_;
   coord_t text_y_;
 
   inline uint8_t *get_frame_ptr(const coord_t x, const coord_t y) __attribute__((always_inline));
   void draw_char(char c, coord_t x, coord_t y);
+  void draw_preshifted_bitmap8(coord_t x, coord_t y, coord_t width, const uint8_t *down, const uint8_t *up);
+  void draw_digits_right(uint32_t value, coord_t x, coord_t y, unsigned digits, uint32_t base);
+  void print_integer(uint32_t value, char sign, unsigned width, unsigned min_digits, uint32_t base);
 };
 
+// Pre-rendered frame contents, drawn with Graphics::BeginLayer/EndLayer. The
+// key identifies what was drawn so it is redrawn when that changes.
+class Layer {
+public:
+  Layer() : owner_(NULL), key_(0), valid_(false) { }
+
+  bool valid(const void *owner, uint32_t key) const {
+    return valid_ && owner == owner_ && key == key_;
+  }
+
+  void Invalidate() {
+    valid_ = false;
+  }
+
+private:
+  friend class Graphics;
+
+  uint8_t data_[Graphics::kFrameSize] __attribute__((aligned(4)));
+  const void *owner_;
+  uint32_t key_;
+  bool valid_;
+};
+
+// Copies of an 8-pixel high bitmap with the columns shifted down by the pixel
+// offsets within a page in shifts (bit n = offset n), split into the parts for
+// the page and the page below. Drawing these is a plain OR, but each offset
+// uses 2 bytes of RAM per column, so only the offsets an icon is actually drawn
+// at should be stored; at other offsets the original data is drawn.
+template <coord_t width, uint8_t shifts = 0xff>
+class PreshiftedBitmap8 {
+public:
+  static_assert(shifts, "PreshiftedBitmap8 needs at least one shift");
+
+  void Init(const uint8_t *data) {
+    data_ = data;
+    int index = 0;
+    for (coord_t shift = 0; shift < 8; ++shift) {
+      if (!(shifts & (1 << shift)))
+        continue;
+      for (coord_t i = 0; i < width; ++i) {
+        down_[index][i] = data[i] << shift;
+        up_[index][i] = data[i] >> (8 - shift);
+      }
+      ++index;
+    }
+  }
+
+private:
+  friend class Graphics;
+
+  static constexpr int count(unsigned bits) {
+    return bits ? (bits & 1) + count(bits >> 1) : 0;
+  }
+
+  // Index of the copy for each shift (if stored)
+  static constexpr uint8_t kIndex[8] = {
+    count(shifts & 0x00), count(shifts & 0x01), count(shifts & 0x03), count(shifts & 0x07),
+    count(shifts & 0x0f), count(shifts & 0x1f), count(shifts & 0x3f), count(shifts & 0x7f)
+  };
+
+  const uint8_t *data_;
+  uint8_t down_[count(shifts)][width] __attribute__((aligned(4)));
+  uint8_t up_[count(shifts)][width] __attribute__((aligned(4)));
+};
+
+template <coord_t width, uint8_t shifts>
+constexpr uint8_t PreshiftedBitmap8<width, shifts>::kIndex[8];
+
+template <coord_t width, uint8_t shifts>
+inline void Graphics::drawBitmap8(coord_t x, coord_t y, const PreshiftedBitmap8<width, shifts> &bitmap) {
+  // y < 0 is drawn unshifted, as in drawBitmap8
+  const coord_t shift = y < 0 ? 0 : y & 0x7;
+  if (shifts & (1 << shift)) {
+    const uint8_t index = PreshiftedBitmap8<width, shifts>::kIndex[shift];
+    draw_preshifted_bitmap8(x, y, width, bitmap.down_[index], bitmap.up_[index]);
+  } else {
+    drawBitmap8(x, y, width, bitmap.data_);
+  }
+}
+
 inline void Graphics::setPixel(coord_t x, coord_t y) {
   *(get_frame_ptr(x, y)) |= (0x1 << (y & 0x7));
 }
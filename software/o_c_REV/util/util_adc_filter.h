@@ -0,0 +1,123 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef UTIL_ADC_FILTER_H_
+#define UTIL_ADC_FILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Filter stages for (fixed-point) ADC values. The stages are stateless types
+// with a static Process function, the state lives in ADCFilterState so a
+// channel can switch between filter chains without re-allocating anything.
+// Each stage type uses its own state fields, so a chain can only contain each
+// stage type once.
+struct ADCFilterState {
+  uint32_t history[2]; // ADCFilterMedian3
+  uint32_t smoothed;   // ADCFilterOnePole, ADCFilterSlewAdaptive
+
+  void Reset(uint32_t value) {
+    history[0] = history[1] = value;
+    smoothed = value;
+  }
+};
+
+struct ADCFilterNone {
+  static inline uint32_t Process(ADCFilterState &, uint32_t value) {
+    return value;
+  }
+};
+
+// smoothed = (smoothed * (2^shift - 1) + value) / 2^shift
+template <uint32_t shift>
+struct ADCFilterOnePole {
+  static inline uint32_t Process(ADCFilterState &state, uint32_t value) {
+    uint32_t smoothed = (state.smoothed * ((1U << shift) - 1) + value) >> shift;
+    state.smoothed = smoothed;
+    return smoothed;
+  }
+};
+
+// Median of the last three values, removes single-sample spikes at the cost
+// of one sample latency.
+struct ADCFilterMedian3 {
+  static inline uint32_t Process(ADCFilterState &state, uint32_t value) {
+    uint32_t a = state.history[0];
+    uint32_t b = state.history[1];
+    state.history[0] = b;
+    state.history[1] = value;
+
+    if (a > b) { uint32_t t = a; a = b; b = t; }
+    if (value < a) return a;
+    if (value > b) return b;
+    return value;
+  }
+};
+
+// One-pole filter whose shift is reduced by one for each doubling of the
+// difference between input and output above the threshold, i.e. it follows
+// steps quickly but smooths heavily when the input is static.
+template <uint32_t min_shift, uint32_t max_shift, uint32_t threshold_bits>
+struct ADCFilterSlewAdaptive {
+  static_assert(min_shift < max_shift, "Invalid shift range");
+
+  static inline uint32_t Process(ADCFilterState &state, uint32_t value) {
+    int32_t delta = static_cast<int32_t>(value - state.smoothed);
+    uint32_t excess = (delta < 0 ? -delta : delta) >> threshold_bits;
+    uint32_t doublings = excess ? 32 - __builtin_clz(excess) : 0;
+    uint32_t shift = doublings < max_shift - min_shift ? max_shift - doublings : min_shift;
+
+    uint32_t smoothed = state.smoothed + (delta >> shift);
+    state.smoothed = smoothed;
+    return smoothed;
+  }
+};
+
+template <typename... Stages> struct ADCFilterChain;
+
+template <>
+struct ADCFilterChain<> {
+  static inline uint32_t Process(ADCFilterState &, uint32_t value) {
+    return value;
+  }
+};
+
+template <typename Stage, typename... Stages>
+struct ADCFilterChain<Stage, Stages...> {
+  static inline uint32_t Process(ADCFilterState &state, uint32_t value) {
+    return ADCFilterChain<Stages...>::Process(state, Stage::Process(state, value));
+  }
+};
+
+// Response profiles for CV inputs. Values have frac_bits fractional bits, the
+// default profile is the original fixed smoothing.
+template <uint32_t frac_bits, uint32_t default_shift>
+struct ADCFilterProfiles {
+  typedef ADCFilterChain<ADCFilterOnePole<default_shift>> Default;
+  typedef ADCFilterChain<ADCFilterNone> None;
+  typedef ADCFilterChain<ADCFilterMedian3, ADCFilterOnePole<default_shift + 2>> Smooth;
+  typedef ADCFilterChain<ADCFilterSlewAdaptive<0, default_shift + 3, frac_bits + 2>> Adaptive;
+};
+
+}; // namespace util
+
+#endif // UTIL_ADC_FILTER_H_
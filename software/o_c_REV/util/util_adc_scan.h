@@ -0,0 +1,240 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef UTIL_ADC_SCAN_H_
+#define UTIL_ADC_SCAN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Raw ADC value to fixed-point value with frac_bits fractional bits (for
+// filtering, see util_adc_filter.h)
+template <uint32_t scan_resolution, uint32_t resolution, uint32_t frac_bits>
+struct ADCScanValue {
+  static inline uint32_t raw(uint32_t value) {
+    return (value >> (scan_resolution - resolution)) << frac_bits;
+  }
+};
+
+// Results of a continuous scan over all channels, i.e. one DMA channel stores
+// conversion results into the ring, and a linked one writes the next channel
+// from the mux sequence to start the next conversion. Entry i in the ring is
+// channel i % channels, and a block is one result for each channel.
+//
+// The scan runs independently, so the reader only knows the current write
+// position and takes the latest complete block from that. If the write
+// position advances by a multiple of the ring size between reads, the new data
+// is missed, so blocks should be sized so that can't happen.
+template <size_t channels, size_t blocks>
+class ADCScanRing {
+public:
+  static constexpr size_t kSize = channels * blocks;
+  static_assert(blocks >= 2, "Need at least one block to read while the next is converted");
+
+  void Init() {
+    for (size_t i = 0; i < kSize; ++i)
+      buffer_[i] = 0;
+    last_block_ = blocks - 1; // nothing written yet
+  }
+
+  // The conversion for channel 0 is started manually, after that the result
+  // of channel i triggers the conversion of channel i + 1.
+  static void InitMuxSequence(const uint8_t *channel_mux, uint32_t *sequence) {
+    for (size_t i = 0; i < channels; ++i)
+      sequence[i] = channel_mux[(i + 1) % channels];
+  }
+
+  volatile uint16_t *buffer() {
+    return buffer_;
+  }
+
+  // @param write_index position of next result in ring (from DMA address)
+  // @param values [out] latest block
+  // @return false if no new complete block since last read
+  bool ReadLatest(size_t write_index, uint16_t *values) {
+    const size_t block = (write_index / channels + blocks - 1) % blocks;
+    if (block == last_block_)
+      return false;
+    last_block_ = block;
+
+    const volatile uint16_t *src = buffer_ + block * channels;
+    for (size_t i = 0; i < channels; ++i)
+      values[i] = src[i];
+    return true;
+  }
+
+private:
+  volatile uint16_t buffer_[kSize];
+  size_t last_block_;
+};
+
+// Schedule for scanning channels one conversion at a time: slots are given
+// to channels in proportion to their weight (at least one each) and spread
+// out evenly, so the time between samples of a channel is roughly constant.
+template <size_t channels, size_t slots>
+class ADCScanSchedule {
+public:
+  static_assert(slots >= channels && slots <= 256, "Invalid number of slots");
+
+  void Init() {
+    uint8_t weights[channels];
+    for (size_t c = 0; c < channels; ++c)
+      weights[c] = 1;
+    Build(weights);
+  }
+
+  void Build(const uint8_t *weights) {
+    uint32_t total = 0;
+    for (size_t c = 0; c < channels; ++c)
+      total += weights[c] ? weights[c] : 1;
+
+    // Largest remainder, but each channel gets at least one slot
+    uint32_t assigned = 0;
+    uint32_t remainders[channels];
+    for (size_t c = 0; c < channels; ++c) {
+      uint32_t weight = weights[c] ? weights[c] : 1;
+      uint32_t count = weight * slots / total;
+      remainders[c] = weight * slots - count * total;
+      if (!count) {
+        count = 1;
+        remainders[c] = 0;
+      }
+      counts_[c] = count;
+      assigned += count;
+    }
+    while (assigned < slots) {
+      size_t best = 0;
+      for (size_t c = 1; c < channels; ++c)
+        if (remainders[c] > remainders[best]) best = c;
+      ++counts_[best];
+      remainders[best] = 0;
+      ++assigned;
+    }
+    while (assigned > slots) {
+      size_t largest = 0;
+      for (size_t c = 1; c < channels; ++c)
+        if (counts_[c] > counts_[largest]) largest = c;
+      --counts_[largest];
+      --assigned;
+    }
+
+    // Interleave by ideal position of each channel's k-th slot, which is
+    // (k + 1/2) * slots / count
+    uint32_t taken[channels];
+    for (size_t c = 0; c < channels; ++c)
+      taken[c] = 0;
+    for (size_t slot = 0; slot < slots; ++slot) {
+      size_t best = channels;
+      for (size_t c = 0; c < channels; ++c) {
+        if (taken[c] >= counts_[c]) continue;
+        if (best == channels ||
+            (2 * taken[c] + 1) * counts_[best] < (2 * taken[best] + 1) * counts_[c])
+          best = c;
+      }
+      ++taken[best];
+      table_[slot] = best;
+    }
+    position_ = 0;
+  }
+
+  inline size_t Next() {
+    size_t channel = table_[position_];
+    position_ = (position_ + 1) % slots;
+    return channel;
+  }
+
+  uint32_t slot_count(size_t channel) const {
+    return counts_[channel];
+  }
+
+  size_t slot(size_t index) const {
+    return table_[index];
+  }
+
+private:
+  uint8_t table_[slots];
+  uint8_t counts_[channels];
+  size_t position_;
+};
+
+// Change detection against several thresholds. Each threshold has its own
+// reference value that is only updated when the threshold is exceeded, so slow
+// drifts are reported once they add up.
+template <size_t thresholds>
+class ADCChangeDetector {
+public:
+  void Init(int32_t value) {
+    for (size_t t = 0; t < thresholds; ++t)
+      last_[t] = value;
+  }
+
+  // @return bitmask of exceeded thresholds (bit t for threshold_values[t])
+  inline uint32_t Update(int32_t value, const int32_t *threshold_values) {
+    uint32_t changed = 0;
+    for (size_t t = 0; t < thresholds; ++t) {
+      int32_t delta = value - last_[t];
+      if (delta > threshold_values[t] || delta < -threshold_values[t]) {
+        last_[t] = value;
+        changed |= 1U << t;
+      }
+    }
+    return changed;
+  }
+
+private:
+  int32_t last_[thresholds];
+};
+
+// Wait for the first value that was converted after a given tick, e.g. to
+// sample a CV on a clock. Ticks are compared with wraparound.
+class ADCSampleWait {
+public:
+  void Init() {
+    pending_ = false;
+  }
+
+  void Start(uint32_t tick) {
+    tick_ = tick;
+    pending_ = true;
+  }
+
+  bool pending() const {
+    return pending_;
+  }
+
+  // @param conversion_tick tick at which the current value's conversion started
+  // @return true once, for the first value converted after the start tick
+  inline bool Ready(uint32_t conversion_tick) {
+    if (!pending_ || static_cast<int32_t>(conversion_tick - tick_) <= 0)
+      return false;
+    pending_ = false;
+    return true;
+  }
+
+private:
+  uint32_t tick_ = 0;
+  bool pending_ = false;
+};
+
+}; // namespace util
+
+#endif // UTIL_ADC_SCAN_H_
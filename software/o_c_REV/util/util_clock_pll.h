@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef UTIL_CLOCK_PLL_H_
+#define UTIL_CLOCK_PLL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Clock period estimator and phase tracker, updated once per tick. Times are
+// in ticks with frac_bits fractional bits; the phase is a 32-bit fraction of
+// the period, 0 at the clock edge.
+//
+// Periods within kToleranceShift of the estimate are smoothed into it and add
+// to the confidence; anything else (tempo change, missed clock) restarts the
+// estimate from the measured period. Without a clock for two periods the lock
+// is lost, but the phase keeps running at the last tempo.
+template <uint32_t frac_bits>
+class ClockPLL {
+public:
+  static constexpr uint32_t kOneTick = 1 << frac_bits;
+  static constexpr uint32_t kSmoothingShift = 2;
+  static constexpr uint32_t kToleranceShift = 3; // 1/8 of the period
+  static constexpr uint32_t kLockConfidence = 4;
+  static constexpr uint32_t kMaxConfidence = 15;
+  static constexpr uint32_t kMaxElapsed = 0x7fffffff;
+
+  void Init() {
+    period_ = 0;
+    elapsed_ = 0;
+    phase_ = 0;
+    phase_inc_ = 0;
+    confidence_ = 0;
+    have_edge_ = false;
+  }
+
+  // @param clocked there were clock edges this tick
+  // @param measured period from edge timestamps, 0 to use tick time
+  // @param age time between latest edge and this tick
+  inline void Update(bool clocked, uint32_t measured, uint32_t age) {
+    if (elapsed_ < kMaxElapsed)
+      elapsed_ += kOneTick;
+    phase_ += phase_inc_;
+
+    if (!clocked) {
+      if (confidence_ && elapsed_ > 2 * period_)
+        confidence_ = 0;
+      return;
+    }
+
+    if (!measured)
+      measured = elapsed_ - age;
+    if (have_edge_)
+      Track(measured);
+    have_edge_ = true;
+    elapsed_ = age;
+
+    // At the edge phase is 0, so at this tick it should be age * phase_inc_.
+    // Once locked only half the error is corrected to smooth out jitter.
+    const uint32_t expected = (static_cast<uint64_t>(age) * phase_inc_) >> frac_bits;
+    if (locked())
+      phase_ -= static_cast<int32_t>(phase_ - expected) / 2;
+    else
+      phase_ = expected;
+  }
+
+  // @return estimated period, 0 if unknown
+  uint32_t period() const {
+    return period_;
+  }
+
+  // @return estimated period in (rounded) whole ticks
+  uint32_t period_ticks() const {
+    return (period_ + kOneTick / 2) >> frac_bits;
+  }
+
+  uint32_t phase() const {
+    return phase_;
+  }
+
+  // @return phase increment per tick
+  uint32_t phase_increment() const {
+    return phase_inc_;
+  }
+
+  uint32_t confidence() const {
+    return confidence_;
+  }
+
+  bool locked() const {
+    return confidence_ >= kLockConfidence;
+  }
+
+private:
+  uint32_t period_;
+  uint32_t elapsed_;
+  uint32_t phase_;
+  uint32_t phase_inc_;
+  uint32_t confidence_;
+  bool have_edge_;
+
+  void Track(uint32_t measured) {
+    const int32_t error = static_cast<int32_t>(measured - period_);
+    const int32_t tolerance = period_ >> kToleranceShift;
+    if (period_ && error <= tolerance && error >= -tolerance) {
+      period_ += error / (1 << kSmoothingShift);
+      if (confidence_ < kMaxConfidence)
+        ++confidence_;
+    } else {
+      period_ = measured;
+      confidence_ = 0;
+    }
+
+    phase_inc_ = PhaseIncrement(period_ > kOneTick ? period_ : kOneTick + 1);
+  }
+
+  // @return 2^(32 + frac_bits) / period, period > kOneTick
+  //
+  // This runs in the ISR, so there's no 64-bit division: the reciprocal of
+  // the normalised period is estimated with a 32-bit division by its top 16
+  // bits and refined with one Newton-Raphson step. The estimate is low, and
+  // the result is within a few LSB below the exact quotient.
+  static uint32_t PhaseIncrement(uint32_t period) {
+    const uint32_t shift = __builtin_clz(period);
+    const uint32_t normalised = period << shift;
+    // ~2^63 / normalised, in [2^31, 2^32)
+    const uint32_t estimate = (0xffffffffUL / ((normalised >> 16) + 1)) << 15;
+    const uint64_t error = (1ULL << 63) - static_cast<uint64_t>(normalised) * estimate;
+    const uint64_t reciprocal = estimate + ((static_cast<uint64_t>(estimate) * static_cast<uint32_t>(error >> 17)) >> 46);
+    return static_cast<uint32_t>(reciprocal >> (31 - frac_bits - shift));
+  }
+};
+
+}; // namespace util
+
+#endif // UTIL_CLOCK_PLL_H_
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef UTIL_EDGE_QUEUE_H_
+#define UTIL_EDGE_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Single-producer, single-consumer queue of timestamped gate edges, written by
+// a pin change ISR and drained once per tick. Each entry is the cycle count
+// with the lowest bit replaced by the edge direction.
+//
+// The ISR determines the direction by reading the pin, so a pulse that is
+// shorter than the ISR latency looks like two edges in the same direction.
+// Pop re-inserts the missing edge (with the same timestamp) so rising and
+// falling edges always alternate. If the queue is full, edges are dropped and
+// counted; that also restores alternation on the next edge.
+template <size_t size>
+class EdgeQueue {
+public:
+  static_assert(size && !(size & (size - 1)), "Size must be a power of two");
+
+  void Init(bool gate) {
+    head_ = tail_ = 0;
+    gate_ = gate;
+    dropped_ = 0;
+  }
+
+  inline void Push(uint32_t cycles, bool rising) {
+    const uint32_t head = head_;
+    if (head - tail_ >= size) {
+      dropped_ = dropped_ + 1;
+      return;
+    }
+    buffer_[head & (size - 1)] = (cycles & ~0x1) | (rising ? 0x1 : 0x0);
+    head_ = head + 1;
+  }
+
+  // @return false if queue is empty
+  inline bool Pop(uint32_t &cycles, bool &rising) {
+    const uint32_t tail = tail_;
+    if (tail == head_)
+      return false;
+
+    const uint32_t edge = buffer_[tail & (size - 1)];
+    cycles = edge & ~0x1;
+    rising = edge & 0x1;
+    if (rising == gate_)
+      rising = !rising; // missed edge, entry stays in queue
+    else
+      tail_ = tail + 1;
+    gate_ = rising;
+    return true;
+  }
+
+  // @return gate state after the last popped edge
+  bool gate() const {
+    return gate_;
+  }
+
+  uint32_t dropped() const {
+    return dropped_;
+  }
+
+private:
+  volatile uint32_t buffer_[size];
+  volatile uint32_t head_;
+  volatile uint32_t tail_;
+  volatile uint32_t dropped_;
+  bool gate_;
+};
+
+}; // namespace util
+
+#endif // UTIL_EDGE_QUEUE_H_
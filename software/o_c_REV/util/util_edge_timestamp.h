@@ -0,0 +1,125 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef UTIL_EDGE_TIMESTAMP_H_
+#define UTIL_EDGE_TIMESTAMP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+#ifdef ARM_DWT_CYCCNT
+static inline uint32_t cycle_count() {
+  return ARM_DWT_CYCCNT;
+}
+#else
+// Host stand-in for the DWT cycle counter, advanced manually by tests
+struct HostCycleCounter {
+  static uint32_t &value() {
+    static uint32_t cycles = 0;
+    return cycles;
+  }
+};
+
+static inline uint32_t cycle_count() {
+  return HostCycleCounter::value();
+}
+#endif
+
+// Cycle-count timestamp of the latest edge on an input. Edge is called for each
+// edge (as drained from the edge queue), Scan once per tick after that.
+//
+// Times are converted to ticks with frac_bits fractional bits, so periods and
+// edge positions within a tick are available to anything that would otherwise
+// only see the tick in which the edge was reported.
+template <uint32_t cycles_per_tick, uint32_t frac_bits>
+class EdgeTimestamp {
+public:
+  static constexpr uint32_t kTickFracBits = frac_bits;
+  static constexpr uint32_t kCyclesPerTick = cycles_per_tick;
+
+  void Init() {
+    cycles_ = 0;
+    edges_ = 0;
+    last_cycles_ = 0;
+    last_edges_ = 0;
+    period_ = 0;
+    age_ = 0;
+  }
+
+  inline void Edge(uint32_t cycles) {
+    cycles_ = cycles;
+    ++edges_;
+  }
+
+  // @param now cycle count at time of scan
+  // @return true if there were edges since the last scan
+  inline bool Scan(uint32_t now) {
+    const uint32_t edges = edges_;
+    if (edges == last_edges_)
+      return false;
+    const uint32_t cycles = cycles_;
+
+    // Several edges between scans are averaged, the first edge has no period
+    if (last_edges_)
+      period_ = cycles_to_ticks((cycles - last_cycles_) / (edges - last_edges_));
+    age_ = cycles_to_ticks(now - cycles);
+    last_cycles_ = cycles;
+    last_edges_ = edges;
+    return true;
+  }
+
+  // @return cycle count of latest scanned edge
+  uint32_t cycles() const {
+    return last_cycles_;
+  }
+
+  // @return ticks between the last two edges (0 if unknown)
+  uint32_t period() const {
+    return period_;
+  }
+
+  // @return ticks between latest edge and the scan that reported it
+  uint32_t age() const {
+    return age_;
+  }
+
+  // cycles * 2^frac_bits / cycles_per_tick, without the division
+  static inline uint32_t cycles_to_ticks(uint32_t cycles) {
+    return (static_cast<uint64_t>(cycles) * kReciprocal) >> 32;
+  }
+
+private:
+  static constexpr uint32_t kReciprocal = ((1ULL << (32 + frac_bits)) + cycles_per_tick - 1) / cycles_per_tick;
+  static_assert(((1ULL << (32 + frac_bits)) / cycles_per_tick) < (1ULL << 32), "Too many fractional bits");
+
+  uint32_t cycles_;
+  uint32_t edges_;
+  uint32_t last_cycles_;
+  uint32_t last_edges_;
+  uint32_t period_;
+  uint32_t age_;
+};
+
+}; // namespace util
+
+#endif // UTIL_EDGE_TIMESTAMP_H_
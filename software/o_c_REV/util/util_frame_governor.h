@@ -0,0 +1,121 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef UTIL_FRAME_GOVERNOR_H_
+#define UTIL_FRAME_GOVERNOR_H_
+
+#include <stdint.h>
+
+namespace util {
+
+// Paces display redraws in the main loop. A frame is due once the frame period
+// has passed since the last one, or immediately after Wake (e.g. UI events).
+// While the load passed in (e.g. ISR cycles per tick, in %) is above the limit,
+// due frames are dropped instead, but never more than kMaxDroppedFrames in a
+// row so the display keeps updating. Times are in us and may wrap.
+class FrameGovernor {
+public:
+  static constexpr uint32_t kMaxDroppedFrames = 3;
+  static constexpr uint32_t kStatsPeriod = 1000000;
+
+  void Init(uint32_t fps, uint32_t max_load) {
+    set_fps(fps);
+    max_load_ = max_load;
+    wake_ = true;
+    last_frame_ = 0;
+    dropped_in_row_ = 0;
+    dropped_frames_ = 0;
+    stats_start_ = 0;
+    stats_frames_ = 0;
+    fps_ = 0;
+  }
+
+  void set_fps(uint32_t fps) {
+    frame_period_ = 1000000 / (fps ? fps : 1);
+  }
+
+  void Wake() {
+    wake_ = true;
+  }
+
+  // @return true if a frame should be drawn; call Drawn if it was
+  bool Due(uint32_t now, uint32_t load) {
+    if (now - stats_start_ >= kStatsPeriod) {
+      fps_ = (static_cast<uint64_t>(stats_frames_) * 1000000) / (now - stats_start_);
+      stats_start_ = now;
+      stats_frames_ = 0;
+    }
+
+    if (wake_)
+      return true;
+    if (now - last_frame_ < frame_period_)
+      return false;
+    if (load > max_load_ && dropped_in_row_ < kMaxDroppedFrames) {
+      ++dropped_in_row_;
+      ++dropped_frames_;
+      next_frame(now);
+      return false;
+    }
+    return true;
+  }
+
+  void Drawn(uint32_t now) {
+    wake_ = false;
+    dropped_in_row_ = 0;
+    next_frame(now);
+    ++stats_frames_;
+  }
+
+  // Frames drawn per second, updated every kStatsPeriod
+  uint32_t fps() const {
+    return fps_;
+  }
+
+  uint32_t dropped_frames() const {
+    return dropped_frames_;
+  }
+
+private:
+  uint32_t frame_period_;
+  uint32_t max_load_;
+  bool wake_;
+  uint32_t last_frame_;
+  uint32_t dropped_in_row_;
+  uint32_t dropped_frames_;
+
+  uint32_t stats_start_;
+  uint32_t stats_frames_;
+  uint32_t fps_;
+
+  // Keep frames on the period grid so drawing time doesn't lower the rate,
+  // unless more than a frame late or woken early
+  void next_frame(uint32_t now) {
+    const uint32_t elapsed = now - last_frame_;
+    if (elapsed >= frame_period_ && elapsed < 2 * frame_period_)
+      last_frame_ += frame_period_;
+    else
+      last_frame_ = now;
+  }
+};
+
+}; // namespace util
+
+#endif // UTIL_FRAME_GOVERNOR_H_
@@ -0,0 +1,162 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef UTIL_FREQUENCY_COUNTER_H_
+#define UTIL_FREQUENCY_COUNTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Reciprocal frequency counter: counts whole periods between the first and
+// last edge in a gate time, so the resolution is one time unit per gate time
+// independent of the frequency. Times are in units_per_second (e.g. CPU
+// cycles) and may wrap around.
+template <uint32_t units_per_second>
+class FrequencyCounter {
+public:
+  void Init(uint32_t gate_time, uint32_t timeout) {
+    gate_time_ = gate_time;
+    timeout_ = timeout;
+    first_ = last_ = 0;
+    edges_ = 0;
+    millihertz_ = 0;
+  }
+
+  inline void Edge(uint32_t time) {
+    if (!edges_)
+      first_ = time;
+    last_ = time;
+    ++edges_;
+  }
+
+  // @param now current time, for the timeout
+  // @return true if there is a new measurement
+  inline bool Update(uint32_t now) {
+    if (!edges_)
+      return false;
+
+    if (now - last_ > timeout_) {
+      edges_ = 0;
+      millihertz_ = 0;
+      return true;
+    }
+
+    const uint32_t span = last_ - first_;
+    if (edges_ < 2 || span < gate_time_)
+      return false;
+
+    millihertz_ = (static_cast<uint64_t>(edges_ - 1) * units_per_second * 1000 + span / 2) / span;
+    first_ = last_;
+    edges_ = 1;
+    return true;
+  }
+
+  // @return last measured frequency, 0 if none
+  uint32_t millihertz() const {
+    return millihertz_;
+  }
+
+private:
+  uint32_t gate_time_;
+  uint32_t timeout_;
+  uint32_t first_;
+  uint32_t last_;
+  uint32_t edges_;
+  uint32_t millihertz_;
+};
+
+// Upwards zero crossings in a sampled signal, with hysteresis so noise around
+// zero doesn't add crossings. The crossing time is interpolated between the
+// samples.
+class ZeroCrossingDetector {
+public:
+  void Init(int32_t hysteresis) {
+    hysteresis_ = hysteresis;
+    armed_ = false;
+    last_value_ = 0;
+    last_time_ = 0;
+  }
+
+  // @param value signed sample, 0 is the zero line
+  // @param time sample time
+  // @param crossing [out] interpolated time of crossing
+  // @return true if the signal crossed zero upwards since the last sample
+  inline bool Process(int32_t value, uint32_t time, uint32_t &crossing) {
+    bool crossed = false;
+    if (value < -hysteresis_) {
+      armed_ = true;
+    } else if (armed_ && value >= 0 && last_value_ < 0) {
+      // Fraction of the sample interval before the crossing, in Q16 with a
+      // 32-bit division. value > last_value_, so this can't divide by zero.
+      uint32_t below = -last_value_;
+      uint32_t span = value - last_value_;
+      while (span > 0xffff) {
+        below >>= 1;
+        span >>= 1;
+      }
+      const uint32_t fraction = (below << 16) / span;
+      crossing = last_time_ + static_cast<uint32_t>((static_cast<uint64_t>(time - last_time_) * fraction) >> 16);
+      armed_ = false;
+      crossed = true;
+    }
+    last_value_ = value;
+    last_time_ = time;
+    return crossed;
+  }
+
+private:
+  int32_t hysteresis_;
+  bool armed_;
+  int32_t last_value_;
+  uint32_t last_time_;
+};
+
+// log2(value) with 16 fractional bits, value > 0
+static inline int32_t log2_q16(uint32_t value) {
+  const uint32_t leading_zeros = __builtin_clz(value);
+  int32_t result = (31 - leading_zeros) << 16;
+
+  // Mantissa in [1, 2) with 31 fractional bits, one result bit per squaring
+  uint64_t mantissa = static_cast<uint64_t>(value) << leading_zeros;
+  for (int32_t bit = 1 << 15; bit; bit >>= 1) {
+    mantissa = (mantissa * mantissa) >> 31;
+    if (mantissa >= (1ULL << 32)) {
+      mantissa >>= 1;
+      result |= bit;
+    }
+  }
+  return result;
+}
+
+// @return interval between frequencies in cents, with 8 fractional bits (0
+// if either is 0)
+static inline int32_t frequency_cents(uint32_t millihertz, uint32_t reference_millihertz) {
+  if (!millihertz || !reference_millihertz)
+    return 0;
+  const int64_t octaves_q16 = log2_q16(millihertz) - log2_q16(reference_millihertz);
+  return (octaves_q16 * 1200) >> 8;
+}
+
+}; // namespace util
+
+#endif // UTIL_FREQUENCY_COUNTER_H_
@@ -0,0 +1,128 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef UTIL_HISTORY_RING_H_
+#define UTIL_HISTORY_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Deep history of a value that is pushed every tick (e.g. from the core ISR).
+// With decimation, 2^n pushed values are averaged into one stored sample.
+//
+// Readers don't copy the data but get a View of the ring buffer itself, so
+// they have to expect the oldest samples to be overwritten if they take more
+// than (size - samples used) * 2^decimation ticks to read. For display
+// purposes that is fine, and it avoids per-frame copies and extra buffers.
+template <typename T, size_t size>
+class HistoryRing {
+public:
+  static_assert(!(size & (size - 1)), "HistoryRing size must be power of 2");
+  static constexpr uint32_t kMaxDecimation = 15;
+
+  // Read-only snapshot: samples are data[(start + i) % length], oldest first
+  struct View {
+    const T *data;
+    size_t length;
+    size_t start;
+
+    inline T operator[](size_t i) const {
+      return data[(start + i) & (size - 1)];
+    }
+
+    // Most recent sample, i.e. (*this)[length - 1]
+    inline T last() const {
+      return data[(start + size - 1) & (size - 1)];
+    }
+  };
+
+  void Init(T value) {
+    for (size_t i = 0; i < size; ++i)
+      buffer_[i] = value;
+    write_index_ = 0;
+    samples_ = 0;
+    accumulator_ = 0;
+    count_ = 0;
+    hold_ = false;
+  }
+
+  void set_decimation(uint32_t decimation) {
+    if (decimation > kMaxDecimation) decimation = kMaxDecimation;
+    decimation_ = decimation;
+    accumulator_ = 0;
+    count_ = 0;
+  }
+
+  uint32_t decimation() const {
+    return decimation_;
+  }
+
+  // While held, pushed values are discarded, so a snapshot stays valid (e.g.
+  // for a frozen scope) without being copied.
+  void set_hold(bool hold) {
+    hold_ = hold;
+  }
+
+  bool hold() const {
+    return hold_;
+  }
+
+  // @return true if a new sample was stored
+  inline bool Push(T value) {
+    if (hold_)
+      return false;
+    accumulator_ += value;
+    if (++count_ < (1U << decimation_))
+      return false;
+
+    size_t index = write_index_;
+    buffer_[index] = accumulator_ >> decimation_;
+    write_index_ = (index + 1) & (size - 1);
+    ++samples_;
+    accumulator_ = 0;
+    count_ = 0;
+    return true;
+  }
+
+  View Snapshot() const {
+    return { buffer_, size, write_index_ };
+  }
+
+  // Total number of stored samples, so readers can tell if/how much new data
+  // is available since the last snapshot.
+  uint32_t samples() const {
+    return samples_;
+  }
+
+private:
+  T buffer_[size];
+  volatile size_t write_index_;
+  volatile uint32_t samples_;
+  int32_t accumulator_;
+  uint32_t count_;
+  uint32_t decimation_ = 0;
+  volatile bool hold_ = false;
+};
+
+}; // namespace util
+
+#endif // UTIL_HISTORY_RING_H_
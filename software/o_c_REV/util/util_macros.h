@@ -5,7 +5,7 @@
 #include <string.h>
 
 #ifndef SWAP
-#define SWAP(a, b) do { typeof(a) t = a; a = b; b = t; } while(0)
+#define SWAP(a, b) do { __typeof__(a) t = a; a = b; b = t; } while(0)
 #endif
 
 #define DISALLOW_COPY_AND_ASSIGN(TypeName) \
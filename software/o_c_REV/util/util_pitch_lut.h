@@ -0,0 +1,95 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef UTIL_PITCH_LUT_H_
+#define UTIL_PITCH_LUT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace util {
+
+// Output voltage scaling as pitch = (pitch * mul) >> shift
+struct PitchScaling {
+  int32_t mul;
+  int32_t shift;
+
+  inline int32_t scale(int32_t pitch) const {
+    return (pitch * mul) >> shift;
+  }
+};
+
+// Pitch (12 << 7 per octave) to DAC value lookup for one calibrated channel.
+//
+// Rebuilt from the calibration table when that changes, so the lookup itself
+// only has to find the octave segment and interpolate. Results are identical
+// to the original signed division/interpolation, i.e.
+//   sample = calibrated[octave] + (fractional * span) / (12 << 7)
+// where the division truncates towards zero for negative spans.
+template <size_t octaves>
+class PitchLUT {
+public:
+  static constexpr int32_t kOctaveUnits = 12 << 7;
+  static constexpr int32_t kMaxPitch = octaves * kOctaveUnits;
+  static_assert(kMaxPitch < (32 << 9), "Octave index calculation is only exact for pitch < 32 << 9");
+
+  void Init(const uint16_t *calibrated_octaves) {
+    for (size_t octave = 0; octave <= octaves; ++octave) {
+      Segment &segment = segments_[octave];
+      int32_t span = octave < octaves
+          ? calibrated_octaves[octave + 1] - calibrated_octaves[octave]
+          : 0;
+      segment.sample = calibrated_octaves[octave];
+      segment.sign = span < 0 ? -1 : 0;
+      segment.span = span < 0 ? -span : span;
+    }
+  }
+
+  inline int32_t lookup(int32_t pitch) const {
+    if (pitch < 0) pitch = 0;
+    else if (pitch > kMaxPitch) pitch = kMaxPitch;
+
+    // pitch / (3 << 9) == (pitch >> 9) / 3, and x / 3 == (x * 11) >> 5 for x < 32
+    const int32_t octave = ((pitch >> 9) * 11) >> 5;
+    const uint32_t fractional = pitch - octave * kOctaveUnits;
+
+    const Segment &segment = segments_[octave];
+    int32_t delta = div_octave_units(fractional * segment.span);
+    return segment.sample + ((delta ^ segment.sign) - segment.sign);
+  }
+
+  // Exact n / (12 << 7) for 32-bit unsigned n: (n * ceil(2^33 / 3)) >> 33 is n / 3
+  static inline uint32_t div_octave_units(uint32_t n) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(n) * 0xAAAAAAABULL) >> (33 + 9));
+  }
+
+private:
+  struct Segment {
+    int32_t sample;
+    uint32_t span;
+    int32_t sign;
+  };
+
+  Segment segments_[octaves + 1];
+};
+
+}; // namespace util
+
+#endif // UTIL_PITCH_LUT_H_
@@ -0,0 +1,189 @@
+// Copyright (c) 2026 Hemisphere Suite contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef UTIL_SIMD2_H_
+#define UTIL_SIMD2_H_
+
+#include <stdint.h>
+
+#if defined(KINETISK)
+#include "../extern/dspinst.h"
+#endif
+
+namespace util {
+
+// Dual 16-bit operations, i.e. two signed 16-bit lanes packed into a single
+// 32-bit word. On the M4 these map onto the DSP extension instructions
+// (SADD16, QADD16, SMUAD etc.); elsewhere (i.e. in the host tests) a portable
+// version mimics the instruction semantics exactly.
+//
+// The low halfword holds channel 0 and the high halfword channel 1, so the
+// ForEachChannel(ch) loop of a Hemisphere applet maps to a single value.
+// Hemisphere CV values (+/- HEMISPHERE_MAX_CV) fit comfortably in 16 bits.
+namespace simd2 {
+
+typedef uint32_t int16x2;
+
+#define SIMD2_INLINE static inline __attribute__((always_inline, unused))
+
+SIMD2_INLINE int16x2 pack(int32_t lo, int32_t hi) {
+  return ((uint32_t)lo & 0xffff) | ((uint32_t)hi << 16);
+}
+
+SIMD2_INLINE int16x2 splat(int32_t value) {
+  return pack(value, value);
+}
+
+SIMD2_INLINE int32_t lo(int16x2 value) {
+  return (int16_t)(value & 0xffff);
+}
+
+SIMD2_INLINE int32_t hi(int16x2 value) {
+  return (int16_t)(value >> 16);
+}
+
+SIMD2_INLINE int32_t lane(int16x2 value, int ch) {
+  return ch ? hi(value) : lo(value);
+}
+
+#if defined(KINETISK)
+
+// SADD16: Wrapping add
+SIMD2_INLINE int16x2 add(int16x2 a, int16x2 b) {
+  int16x2 out;
+  asm volatile("sadd16 %0, %1, %2" : "=r" (out) : "r" (a), "r" (b) : "cc");
+  return out;
+}
+
+// SSUB16: Wrapping subtract
+SIMD2_INLINE int16x2 sub(int16x2 a, int16x2 b) {
+  int16x2 out;
+  asm volatile("ssub16 %0, %1, %2" : "=r" (out) : "r" (a), "r" (b) : "cc");
+  return out;
+}
+
+// QADD16: Saturating add
+SIMD2_INLINE int16x2 qadd(int16x2 a, int16x2 b) {
+  return signed_add_16_and_16(a, b);
+}
+
+// QSUB16: Saturating subtract
+SIMD2_INLINE int16x2 qsub(int16x2 a, int16x2 b) {
+  return signed_subtract_16_and_16(a, b);
+}
+
+// SMUAD: lo(a) * lo(b) + hi(a) * hi(b)
+SIMD2_INLINE int32_t dot(int16x2 a, int16x2 b) {
+  return multiply_16tx16t_add_16bx16b(a, b);
+}
+
+// SMUADX: lo(a) * hi(b) + hi(a) * lo(b)
+SIMD2_INLINE int32_t dotx(int16x2 a, int16x2 b) {
+  return multiply_16tx16b_add_16bx16t(a, b);
+}
+
+// SMLAD: acc + lo(a) * lo(b) + hi(a) * hi(b)
+SIMD2_INLINE int32_t dot_acc(int32_t acc, int16x2 a, int16x2 b) {
+  int32_t out;
+  asm volatile("smlad %0, %1, %2, %3" : "=r" (out) : "r" (a), "r" (b), "r" (acc));
+  return out;
+}
+
+// Per-lane (a * b) >> shift, with results truncated to 16 bits
+template <int shift>
+SIMD2_INLINE int16x2 mul_shift(int16x2 a, int16x2 b) {
+  return pack(multiply_16bx16b(a, b) >> shift, multiply_16tx16t(a, b) >> shift);
+}
+
+// Per-lane min(max(value, min_value), max_value) using SSUB16 to set the GE
+// flags and SEL to pick the result; SSUB16 compares at full precision.
+SIMD2_INLINE int16x2 clamp(int16x2 value, int16x2 min_value, int16x2 max_value) {
+  int16x2 tmp;
+  asm volatile(
+    "ssub16 %0, %1, %3\n\t"
+    "sel %1, %3, %1\n\t"
+    "ssub16 %0, %1, %2\n\t"
+    "sel %1, %1, %2"
+    : "=&r" (tmp), "+r" (value)
+    : "r" (min_value), "r" (max_value)
+    : "cc");
+  return value;
+}
+
+#else // !KINETISK
+
+SIMD2_INLINE int32_t saturate16(int32_t value) {
+  return value > 32767 ? 32767 : (value < -32768 ? -32768 : value);
+}
+
+SIMD2_INLINE int16x2 add(int16x2 a, int16x2 b) {
+  return pack(lo(a) + lo(b), hi(a) + hi(b));
+}
+
+SIMD2_INLINE int16x2 sub(int16x2 a, int16x2 b) {
+  return pack(lo(a) - lo(b), hi(a) - hi(b));
+}
+
+SIMD2_INLINE int16x2 qadd(int16x2 a, int16x2 b) {
+  return pack(saturate16(lo(a) + lo(b)), saturate16(hi(a) + hi(b)));
+}
+
+SIMD2_INLINE int16x2 qsub(int16x2 a, int16x2 b) {
+  return pack(saturate16(lo(a) - lo(b)), saturate16(hi(a) - hi(b)));
+}
+
+// The only overflow case for SMUAD (-32768 * -32768 * 2) wraps, so use
+// unsigned arithmetic to get the same result without UB.
+SIMD2_INLINE int32_t dot(int16x2 a, int16x2 b) {
+  return (int32_t)((uint32_t)(lo(a) * lo(b)) + (uint32_t)(hi(a) * hi(b)));
+}
+
+SIMD2_INLINE int32_t dotx(int16x2 a, int16x2 b) {
+  return (int32_t)((uint32_t)(lo(a) * hi(b)) + (uint32_t)(hi(a) * lo(b)));
+}
+
+SIMD2_INLINE int32_t dot_acc(int32_t acc, int16x2 a, int16x2 b) {
+  return (int32_t)((uint32_t)acc + (uint32_t)dot(a, b));
+}
+
+template <int shift>
+SIMD2_INLINE int16x2 mul_shift(int16x2 a, int16x2 b) {
+  return pack((lo(a) * lo(b)) >> shift, (hi(a) * hi(b)) >> shift);
+}
+
+SIMD2_INLINE int16x2 clamp(int16x2 value, int16x2 min_value, int16x2 max_value) {
+  int32_t l = lo(value);
+  if (l >= lo(max_value)) l = lo(max_value);
+  if (l < lo(min_value)) l = lo(min_value);
+  int32_t h = hi(value);
+  if (h >= hi(max_value)) h = hi(max_value);
+  if (h < hi(min_value)) h = hi(min_value);
+  return pack(l, h);
+}
+
+#endif // KINETISK
+
+#undef SIMD2_INLINE
+
+}; // namespace simd2
+
+}; // namespace util
+
+#endif // UTIL_SIMD2_H_
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include "util/util_adc_filter.h"
+
+#include <cmath>
+#include <random>
+
+// Same as OC::ADC without ADC_DMA_SCAN: 12 bit values with 8 fractional bits
+static constexpr uint32_t kFracBits = 8;
+typedef util::ADCFilterProfiles<kFracBits, 2> Profiles;
+
+static constexpr uint32_t LSB(uint32_t value) { return value << kFracBits; }
+
+struct FilterResponse {
+  uint32_t latency;   // updates until output is within 1 LSB after a step
+  double noise_rms;   // output RMS in LSB with noisy constant input
+  double spike_max;   // max. output deviation in LSB with single-sample spikes
+};
+
+template <typename Filter>
+FilterResponse measure() {
+  FilterResponse response;
+  util::ADCFilterState state;
+
+  // Step response, up 800 LSB (about 1V)
+  state.Reset(LSB(1000));
+  response.latency = 0;
+  for (uint32_t i = 1; i < 1000 && !response.latency; ++i) {
+    uint32_t output = Filter::Process(state, LSB(1800));
+    if (LSB(1800) - output <= LSB(1))
+      response.latency = i;
+  }
+
+  // Uniform noise +-4 LSB
+  std::mt19937 rng(0x5eed);
+  std::uniform_int_distribution<int> noise(-4, 4);
+  state.Reset(LSB(2048));
+  double sum = 0;
+  const int samples = 4096;
+  for (int i = 0; i < 256 + samples; ++i) {
+    uint32_t output = Filter::Process(state, LSB(2048 + noise(rng)));
+    double error = (static_cast<double>(output) - LSB(2048)) / LSB(1);
+    if (i >= 256)
+      sum += error * error;
+  }
+  response.noise_rms = std::sqrt(sum / samples);
+
+  // Single-sample spikes of 200 LSB
+  state.Reset(LSB(2048));
+  response.spike_max = 0;
+  for (int i = 0; i < 1024; ++i) {
+    uint32_t input = (i % 64) == 32 ? LSB(2248) : LSB(2048);
+    double error = std::fabs((static_cast<double>(Filter::Process(state, input)) - LSB(2048)) / LSB(1));
+    if (error > response.spike_max)
+      response.spike_max = error;
+  }
+
+  return response;
+}
+
+TEST(ADCFilterTest, OnePoleIsOriginalSmoothing) {
+  util::ADCFilterState state;
+  state.Reset(0);
+  uint32_t smoothed = 0;
+  std::mt19937 rng(0x1234);
+  for (int i = 0; i < 10000; ++i) {
+    uint32_t value = LSB(rng() & 0xfff) | (rng() & 0xff);
+    smoothed = (smoothed * (4 - 1) + value) / 4;
+    ASSERT_EQ(smoothed, util::ADCFilterOnePole<2>::Process(state, value));
+  }
+}
+
+TEST(ADCFilterTest, Median3) {
+  util::ADCFilterState state;
+  state.Reset(10);
+  EXPECT_EQ(10U, util::ADCFilterMedian3::Process(state, 100));
+  EXPECT_EQ(20U, util::ADCFilterMedian3::Process(state, 20));
+  EXPECT_EQ(20U, util::ADCFilterMedian3::Process(state, 5));
+  EXPECT_EQ(20U, util::ADCFilterMedian3::Process(state, 30));
+  EXPECT_EQ(30U, util::ADCFilterMedian3::Process(state, 30));
+}
+
+TEST(ADCFilterTest, Chain) {
+  util::ADCFilterState state;
+  state.Reset(0);
+  // Spike is removed by median before it gets to the one-pole
+  typedef util::ADCFilterChain<util::ADCFilterMedian3, util::ADCFilterOnePole<1>> Chain;
+  EXPECT_EQ(0U, Chain::Process(state, 1000));
+  EXPECT_EQ(0U, Chain::Process(state, 0));
+  EXPECT_EQ(50U, Chain::Process(state, 100));
+  EXPECT_EQ(75U, Chain::Process(state, 100));
+}
+
+TEST(ADCFilterTest, Profiles) {
+  const FilterResponse none = measure<Profiles::None>();
+  const FilterResponse def = measure<Profiles::Default>();
+  const FilterResponse smooth = measure<Profiles::Smooth>();
+  const FilterResponse adaptive = measure<Profiles::Adaptive>();
+
+  // None: no latency, all the noise
+  EXPECT_EQ(1U, none.latency);
+  EXPECT_NEAR(2.58, none.noise_rms, 0.1);
+  EXPECT_EQ(200, none.spike_max);
+
+  // Default: 24 updates, i.e. ~6ms at 4 * 60us per update
+  EXPECT_LE(def.latency, 25U);
+  EXPECT_LT(def.noise_rms, none.noise_rms / 2);
+  EXPECT_GE(def.spike_max, 50);
+
+  // Smooth: slower, but less noise and spikes are rejected entirely
+  EXPECT_GT(smooth.latency, def.latency);
+  EXPECT_LT(smooth.noise_rms, def.noise_rms);
+  EXPECT_LT(smooth.spike_max, 1);
+
+  // Adaptive: follows steps (and spikes) immediately, but with less noise
+  // than default when the input is static
+  EXPECT_LE(adaptive.latency, 2U);
+  EXPECT_LT(adaptive.noise_rms, def.noise_rms);
+}
+
+TEST(ADCFilterTest, AdaptiveDownwards) {
+  // Negative deltas must not get stuck or wrap
+  util::ADCFilterState state;
+  state.Reset(LSB(4000));
+  uint32_t output = 0;
+  for (int i = 0; i < 100; ++i)
+    output = Profiles::Adaptive::Process(state, LSB(100));
+  EXPECT_EQ(LSB(100), output);
+
+  state.Reset(LSB(100) + 5);
+  for (int i = 0; i < 100; ++i)
+    output = Profiles::Adaptive::Process(state, LSB(100));
+  EXPECT_LE(output - LSB(100), LSB(1));
+}
@@ -0,0 +1,240 @@
+#include "gtest/gtest.h"
+#include "util/util_adc_scan.h"
+
+static constexpr size_t kChannels = 4;
+static constexpr size_t kBlocks = 4;
+typedef util::ADCScanRing<kChannels, kBlocks> ScanRing;
+typedef util::ADCScanValue<16, 12, 8> ScanValue;
+
+// Simulates the linked result/mux DMA channels: each conversion converts the
+// channel currently in the mux, stores the result at the write position and
+// then writes the next mux entry from the sequence.
+class SimulatedADC {
+public:
+  SimulatedADC(ScanRing &ring, const uint8_t *channel_mux)
+  : ring_(ring)
+  , channel_mux_(channel_mux)
+  , write_index_(0)
+  , sequence_index_(0)
+  , conversions_(0) {
+    ring_.Init();
+    ScanRing::InitMuxSequence(channel_mux, sequence_);
+    mux_ = channel_mux[0]; // first conversion is started manually
+  }
+
+  void Convert(size_t conversions) {
+    while (conversions--) {
+      ring_.buffer()[write_index_] = input(mux_);
+      write_index_ = (write_index_ + 1) % ScanRing::kSize;
+      mux_ = sequence_[sequence_index_];
+      sequence_index_ = (sequence_index_ + 1) % kChannels;
+      ++conversions_;
+    }
+  }
+
+  size_t write_index() const {
+    return write_index_;
+  }
+
+  // Value is unique per channel (via the mux code) and conversion
+  uint16_t input(uint8_t mux) const {
+    return mux * 1000 + conversions_ / kChannels;
+  }
+
+  uint8_t mux_to_channel(uint8_t mux) const {
+    for (size_t i = 0; i < kChannels; ++i)
+      if (channel_mux_[i] == mux) return i;
+    return 0xff;
+  }
+
+private:
+  ScanRing &ring_;
+  const uint8_t *channel_mux_;
+  uint32_t sequence_[kChannels];
+  size_t write_index_;
+  size_t sequence_index_;
+  uint32_t conversions_;
+  uint8_t mux_;
+};
+
+// SC1A channels of A3-A6 (CV1-CV4)
+static const uint8_t kChannelMux[kChannels] = { 9, 13, 12, 6 };
+
+TEST(ADCScanTest, MuxSequence) {
+  uint32_t sequence[kChannels];
+  ScanRing::InitMuxSequence(kChannelMux, sequence);
+  EXPECT_EQ(13U, sequence[0]);
+  EXPECT_EQ(12U, sequence[1]);
+  EXPECT_EQ(6U, sequence[2]);
+  EXPECT_EQ(9U, sequence[3]);
+}
+
+TEST(ADCScanTest, ChannelOrdering) {
+  ScanRing ring;
+  SimulatedADC adc(ring, kChannelMux);
+  uint16_t values[kChannels];
+
+  EXPECT_FALSE(ring.ReadLatest(adc.write_index(), values)) << "No complete block yet";
+
+  uint32_t blocks = 0;
+  for (size_t step = 0; step < 100; ++step) {
+    // Irregular steps so the write position isn't always at a block boundary
+    adc.Convert(1 + (step % 7));
+    if (!ring.ReadLatest(adc.write_index(), values))
+      continue;
+    ++blocks;
+    for (size_t channel = 0; channel < kChannels; ++channel) {
+      EXPECT_EQ(channel, adc.mux_to_channel(values[channel] / 1000)) << "step=" << step;
+      // All values in a block are from the same scan
+      EXPECT_EQ(values[0] % 1000, values[channel] % 1000);
+    }
+  }
+  EXPECT_GT(blocks, 50U);
+}
+
+TEST(ADCScanTest, LatestBlock) {
+  ScanRing ring;
+  SimulatedADC adc(ring, kChannelMux);
+  uint16_t values[kChannels];
+
+  // Several blocks between reads: only the latest is returned
+  adc.Convert(kChannels * 3 + 2);
+  ASSERT_TRUE(ring.ReadLatest(adc.write_index(), values));
+  for (size_t channel = 0; channel < kChannels; ++channel)
+    EXPECT_EQ(kChannelMux[channel] * 1000 + 2, values[channel]);
+
+  // Partial block isn't new data
+  adc.Convert(1);
+  EXPECT_FALSE(ring.ReadLatest(adc.write_index(), values));
+  adc.Convert(1);
+  ASSERT_TRUE(ring.ReadLatest(adc.write_index(), values));
+  EXPECT_EQ(kChannelMux[0] * 1000 + 3, values[0]);
+  EXPECT_FALSE(ring.ReadLatest(adc.write_index(), values));
+
+  // Wrap around the ring
+  adc.Convert(kChannels * 5);
+  ASSERT_TRUE(ring.ReadLatest(adc.write_index(), values));
+  EXPECT_EQ(kChannelMux[3] * 1000 + 8, values[3]);
+}
+
+TEST(ADCScanTest, ScanValue) {
+  // 16 bit scan value to 12 bit with 8 fractional bits
+  EXPECT_EQ(0x123U << 8, ScanValue::raw(0x123f));
+}
+
+TEST(ADCScanTest, ChangeDetector) {
+  static const int32_t kThresholds[] = { 8, 32, 128 };
+  util::ADCChangeDetector<3> detector;
+  detector.Init(0);
+
+  EXPECT_EQ(0U, detector.Update(8, kThresholds));
+  EXPECT_EQ(0x1U, detector.Update(9, kThresholds));
+  EXPECT_EQ(0x3U, detector.Update(-33, kThresholds));
+  EXPECT_EQ(0x0U, detector.Update(-28, kThresholds));
+  EXPECT_EQ(0x7U, detector.Update(200, kThresholds));
+
+  // Slow drift is reported once it exceeds the threshold in total
+  uint32_t changes[3] = { 0, 0, 0 };
+  for (int32_t value = 200; value <= 200 + 256; ++value) {
+    uint32_t changed = detector.Update(value, kThresholds);
+    for (int t = 0; t < 3; ++t)
+      changes[t] += (changed >> t) & 1;
+  }
+  EXPECT_EQ(256U / 9, changes[0]);
+  EXPECT_EQ(256U / 33, changes[1]);
+  EXPECT_EQ(256U / 129, changes[2]);
+}
+
+TEST(ADCScanTest, SampleWait) {
+  util::ADCSampleWait wait;
+  wait.Init();
+  EXPECT_FALSE(wait.Ready(100));
+
+  wait.Start(10);
+  EXPECT_TRUE(wait.pending());
+  EXPECT_FALSE(wait.Ready(9));
+  EXPECT_FALSE(wait.Ready(10));
+  EXPECT_TRUE(wait.Ready(11));
+  EXPECT_FALSE(wait.Ready(12)) << "Only the first value after the start tick";
+
+  // Tick counter wraparound
+  wait.Start(0xfffffffe);
+  EXPECT_FALSE(wait.Ready(0xfffffffe));
+  EXPECT_TRUE(wait.Ready(1));
+}
+
+TEST(ADCScanTest, SampleWaitRoundRobin) {
+  // Single conversion per tick, channels in turn: the value read in tick t was
+  // started in tick t - 1. Input steps on the clock, so any value started
+  // after the clock tick must be the new one.
+  for (uint32_t clock_tick = 100; clock_tick < 100 + kChannels; ++clock_tick) {
+    for (size_t channel = 0; channel < kChannels; ++channel) {
+      util::ADCSampleWait wait;
+      wait.Init();
+      uint32_t conversion_tick = 0;
+      int value = 0;
+      uint32_t latency = 0;
+      for (uint32_t tick = 1; tick < 200; ++tick) {
+        if ((tick - 1) % kChannels == channel) { // read channel converted in tick - 1
+          conversion_tick = tick - 1;
+          value = conversion_tick > clock_tick ? 1 : 0;
+        }
+        if (tick == clock_tick)
+          wait.Start(tick);
+        if (wait.Ready(conversion_tick)) {
+          EXPECT_EQ(1, value);
+          latency = tick - clock_tick;
+          break;
+        }
+      }
+      EXPECT_GE(latency, 2U);
+      EXPECT_LE(latency, 1 + kChannels);
+    }
+  }
+}
+
+TEST(ADCScanTest, ScheduleEqual) {
+  util::ADCScanSchedule<kChannels, 16> schedule;
+  schedule.Init();
+  for (size_t i = 0; i < 64; ++i)
+    EXPECT_EQ(i % kChannels, schedule.Next());
+}
+
+TEST(ADCScanTest, ScheduleWeighted) {
+  static const size_t kSlots = 16;
+  static const uint8_t weights[][kChannels] = {
+    { 4, 1, 1, 1 }, { 0, 0, 8, 0 }, { 1, 2, 3, 4 }, { 255, 1, 255, 1 }, { 1, 1, 1, 1 }
+  };
+  for (const auto &w : weights) {
+    util::ADCScanSchedule<kChannels, kSlots> schedule;
+    schedule.Build(w);
+
+    uint32_t total = 0;
+    for (size_t c = 0; c < kChannels; ++c) {
+      EXPECT_GE(schedule.slot_count(c), 1U);
+      total += schedule.slot_count(c);
+    }
+    EXPECT_EQ(kSlots, total);
+
+    // Each channel appears slot_count times, and evenly spread out
+    for (size_t c = 0; c < kChannels; ++c) {
+      size_t count = 0, last = 0, max_gap = 0;
+      for (size_t i = 0; i < 2 * kSlots; ++i) {
+        if (schedule.slot(i % kSlots) != c) continue;
+        if (i < kSlots) ++count;
+        if (count > 1 || i >= kSlots) {
+          if (i - last > max_gap) max_gap = i - last;
+        }
+        last = i;
+      }
+      EXPECT_EQ(schedule.slot_count(c), count);
+      EXPECT_LE(max_gap, (kSlots + schedule.slot_count(c) - 1) / schedule.slot_count(c) + 2) << "channel=" << c;
+    }
+  }
+
+  util::ADCScanSchedule<kChannels, kSlots> schedule;
+  schedule.Build(weights[0]);
+  EXPECT_EQ(9U, schedule.slot_count(0)); // 9.14
+  EXPECT_EQ(3U, schedule.slot_count(1)); // 2.29, largest remainder
+  EXPECT_EQ(2U, schedule.slot_count(2));
+}
@@ -0,0 +1,157 @@
+#include "gtest/gtest.h"
+#include "util/util_clock_pll.h"
+
+#include <cmath>
+#include <random>
+
+static constexpr uint32_t kFracBits = 8;
+typedef util::ClockPLL<kFracBits> ClockPLL;
+static constexpr uint32_t kOneTick = 1 << kFracBits;
+
+// Clock with a period in (fractional) ticks and optional jitter per edge.
+// Edges are reported in the tick after they occur, with or without timestamps.
+class SimulatedClock {
+public:
+  SimulatedClock(ClockPLL &pll, double period, double jitter, bool timestamps)
+  : pll_(pll)
+  , period_(period)
+  , jitter_(jitter)
+  , timestamps_(timestamps)
+  , rng_(0xc10c)
+  , next_edge_(10.3)
+  , last_edge_(0)
+  , tick_(0) {
+    pll_.Init();
+  }
+
+  // @return true if clocked this tick
+  bool Tick() {
+    ++tick_;
+    bool clocked = false;
+    uint32_t measured = 0, age = 0;
+    if (next_edge_ <= tick_) {
+      clocked = true;
+      if (timestamps_) {
+        if (last_edge_ > 0)
+          measured = static_cast<uint32_t>((next_edge_ - last_edge_) * kOneTick);
+        age = static_cast<uint32_t>((tick_ - next_edge_) * kOneTick);
+      }
+      last_edge_ = next_edge_;
+      std::uniform_real_distribution<double> jitter(-jitter_, jitter_);
+      next_edge_ += period_ + jitter(rng_);
+    }
+    pll_.Update(clocked, measured, age);
+    return clocked;
+  }
+
+  void set_period(double period) {
+    next_edge_ += period - period_;
+    period_ = period;
+  }
+
+  // @return phase of the ideal (jitter-free) clock at this tick
+  double ideal_phase() const {
+    double phase = (tick_ - last_edge_) / period_;
+    return phase - std::floor(phase);
+  }
+
+private:
+  ClockPLL &pll_;
+  double period_;
+  double jitter_;
+  bool timestamps_;
+  std::mt19937 rng_;
+  double next_edge_;
+  double last_edge_;
+  uint32_t tick_;
+};
+
+static double period_ticks(const ClockPLL &pll) {
+  return static_cast<double>(pll.period()) / kOneTick;
+}
+
+TEST(ClockPLLTest, LocksOnTickQuantisedClock) {
+  ClockPLL pll;
+  SimulatedClock clock(pll, 100.45, 0, false);
+  uint32_t clocks = 0;
+  while (clocks < 3)
+    clocks += clock.Tick();
+  EXPECT_FALSE(pll.locked());
+
+  for (int tick = 0; tick < 100 * 100; ++tick)
+    clock.Tick();
+  EXPECT_TRUE(pll.locked());
+  // Raw tick periods are 100 or 101
+  EXPECT_NEAR(100.45, period_ticks(pll), 0.6);
+  EXPECT_EQ(100U, pll.period_ticks());
+}
+
+TEST(ClockPLLTest, SmoothsJitter) {
+  ClockPLL pll;
+  SimulatedClock clock(pll, 250.0, 10.0, true);
+  double max_error = 0, max_phase_error = 0;
+  for (int tick = 0; tick < 250 * 200; ++tick) {
+    clock.Tick();
+    if (tick < 250 * 20)
+      continue;
+    EXPECT_TRUE(pll.locked());
+    max_error = std::max(max_error, std::fabs(period_ticks(pll) - 250.0));
+
+    double phase_error = pll.phase() / 4294967296.0 - clock.ideal_phase();
+    phase_error -= std::round(phase_error);
+    max_phase_error = std::max(max_phase_error, std::fabs(phase_error));
+  }
+  // Each raw period is up to 20 ticks off
+  EXPECT_LT(max_error, 10.0);
+  EXPECT_LT(max_phase_error, 0.05);
+}
+
+TEST(ClockPLLTest, TempoChange) {
+  ClockPLL pll;
+  SimulatedClock clock(pll, 100.0, 0, true);
+  for (int tick = 0; tick < 100 * 10; ++tick)
+    clock.Tick();
+  EXPECT_TRUE(pll.locked());
+  EXPECT_EQ(100U, pll.period_ticks());
+
+  clock.set_period(150.0);
+  uint32_t clocks = 0;
+  while (clocks < 2)
+    clocks += clock.Tick();
+  EXPECT_FALSE(pll.locked());
+  EXPECT_EQ(150U, pll.period_ticks()) << "Restarts from measured period";
+
+  while (clocks < 2 + ClockPLL::kLockConfidence)
+    clocks += clock.Tick();
+  EXPECT_TRUE(pll.locked());
+}
+
+TEST(ClockPLLTest, LosesLock) {
+  ClockPLL pll;
+  pll.Init();
+  for (uint32_t tick = 1; tick <= 1000; ++tick)
+    pll.Update(tick % 100 == 0, 0, 0);
+  EXPECT_TRUE(pll.locked());
+  EXPECT_EQ(100 * kOneTick, pll.period());
+
+  // No clock for two periods
+  for (uint32_t tick = 0; tick < 200; ++tick)
+    pll.Update(false, 0, 0);
+  EXPECT_TRUE(pll.locked());
+  pll.Update(false, 0, 0);
+  EXPECT_FALSE(pll.locked());
+  EXPECT_EQ(100 * kOneTick, pll.period()) << "Last period is kept";
+}
+
+TEST(ClockPLLTest, PhaseIncrement) {
+  // Within a few LSB below the exact 64-bit quotient over the whole range
+  for (uint64_t period = kOneTick + 1; period <= 0xffffffffULL; period += (period >> 8) + 1) {
+    ClockPLL pll;
+    pll.Init();
+    pll.Update(true, 0, 0);
+    pll.Update(true, static_cast<uint32_t>(period), 0);
+    const uint64_t exact = (1ULL << (32 + kFracBits)) / period;
+    ASSERT_LE(pll.phase_increment(), exact) << period;
+    ASSERT_GE(pll.phase_increment() + 8, exact) << period;
+  }
+}
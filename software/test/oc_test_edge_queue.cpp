@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+#include "util/util_edge_queue.h"
+
+#include <vector>
+
+static constexpr size_t kQueueSize = 16;
+typedef util::EdgeQueue<kQueueSize> EdgeQueue;
+
+// 120MHz, 60us ticks
+static constexpr uint32_t kCyclesPerTick = 7200;
+
+struct DrainResult {
+  uint32_t rising;
+  uint32_t falling;
+  uint32_t max_per_tick;
+  bool ordered;
+};
+
+// Gate input with a pin change interrupt: the ISR runs `latency` cycles after
+// a change and reads the pin level then. Changes while the ISR is pending only
+// set the (already set) interrupt flag. The queue is drained once per tick.
+DrainResult simulate(const std::vector<uint32_t> &changes, uint32_t latency, uint32_t ticks) {
+  EdgeQueue queue;
+  queue.Init(false);
+  DrainResult result = { 0, 0, 0, true };
+
+  size_t next_change = 0;
+  uint32_t last_cycles = 0;
+  for (uint32_t tick = 0; tick < ticks; ++tick) {
+    const uint32_t tick_end = (tick + 1) * kCyclesPerTick;
+    while (next_change < changes.size() && changes[next_change] + latency < tick_end) {
+      const uint32_t isr = changes[next_change] + latency;
+      // Everything up to the ISR is handled by it
+      while (next_change < changes.size() && changes[next_change] <= isr)
+        ++next_change;
+      queue.Push(isr, next_change & 1); // odd number of changes = high
+    }
+
+    uint32_t cycles, edges = 0;
+    bool rising;
+    while (queue.Pop(cycles, rising)) {
+      if (cycles < last_cycles) result.ordered = false;
+      last_cycles = cycles;
+      if (rising) ++result.rising; else ++result.falling;
+      ++edges;
+    }
+    if (edges > result.max_per_tick) result.max_per_tick = edges;
+  }
+  return result;
+}
+
+TEST(EdgeQueueTest, Alternating) {
+  EdgeQueue queue;
+  queue.Init(false);
+  uint32_t cycles;
+  bool rising;
+  EXPECT_FALSE(queue.Pop(cycles, rising));
+
+  queue.Push(100, true);
+  queue.Push(201, false);
+  ASSERT_TRUE(queue.Pop(cycles, rising));
+  EXPECT_TRUE(rising);
+  EXPECT_EQ(100U, cycles);
+  EXPECT_TRUE(queue.gate());
+  ASSERT_TRUE(queue.Pop(cycles, rising));
+  EXPECT_FALSE(rising);
+  EXPECT_EQ(200U, cycles) << "Lowest bit is the direction";
+  EXPECT_FALSE(queue.Pop(cycles, rising));
+  EXPECT_FALSE(queue.gate());
+}
+
+TEST(EdgeQueueTest, MissedEdge) {
+  EdgeQueue queue;
+  queue.Init(false);
+  uint32_t cycles;
+  bool rising;
+
+  // Pulse shorter than ISR latency, both ISRs see the pin low
+  queue.Push(100, false);
+  queue.Push(110, false);
+  const bool expected[] = { true, false, true, false };
+  const uint32_t expected_cycles[] = { 100, 100, 110, 110 };
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.Pop(cycles, rising));
+    EXPECT_EQ(expected[i], rising) << i;
+    EXPECT_EQ(expected_cycles[i], cycles) << i;
+  }
+  EXPECT_FALSE(queue.Pop(cycles, rising));
+}
+
+TEST(EdgeQueueTest, Overflow) {
+  EdgeQueue queue;
+  queue.Init(false);
+  for (uint32_t i = 0; i < kQueueSize + 3; ++i)
+    queue.Push(i * 2, !(i & 1));
+  EXPECT_EQ(3U, queue.dropped());
+
+  uint32_t cycles, count = 0;
+  bool rising;
+  while (queue.Pop(cycles, rising)) {
+    EXPECT_EQ(!(count & 1), rising);
+    ++count;
+  }
+  EXPECT_EQ(kQueueSize, count);
+
+  // Space again after draining
+  queue.Push(1000, true);
+  EXPECT_EQ(3U, queue.dropped());
+  EXPECT_TRUE(queue.Pop(cycles, rising));
+}
+
+TEST(EdgeQueueTest, Burst20kHz) {
+  // 1000 pulses at 20kHz (50us), 50% duty cycle
+  std::vector<uint32_t> changes;
+  const uint32_t period = 120000000 / 20000;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    changes.push_back(1000 + i * period);
+    changes.push_back(1000 + i * period + period / 2);
+  }
+  DrainResult result = simulate(changes, 50, 1000);
+  EXPECT_EQ(1000U, result.rising);
+  EXPECT_EQ(1000U, result.falling);
+  EXPECT_TRUE(result.ordered);
+  EXPECT_GE(result.max_per_tick, 3U) << "Several edges per tick";
+  EXPECT_LE(result.max_per_tick, kQueueSize);
+}
+
+TEST(EdgeQueueTest, ShortPulses) {
+  // 20kHz 0.25us trigger pulses, shorter than the ISR latency
+  std::vector<uint32_t> changes;
+  const uint32_t period = 120000000 / 20000;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    changes.push_back(1000 + i * period);
+    changes.push_back(1000 + i * period + 30);
+  }
+  DrainResult result = simulate(changes, 50, 1000);
+  EXPECT_EQ(1000U, result.rising);
+  EXPECT_EQ(1000U, result.falling);
+  EXPECT_TRUE(result.ordered);
+}
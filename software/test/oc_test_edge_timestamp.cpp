@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "util/util_edge_timestamp.h"
+
+#include <cmath>
+#include <vector>
+
+// 120MHz, 60us ticks as OC::DigitalInputs
+static constexpr uint32_t kCyclesPerTick = 7200;
+static constexpr uint32_t kFracBits = 8;
+typedef util::EdgeTimestamp<kCyclesPerTick, kFracBits> EdgeTimestamp;
+
+static constexpr uint32_t kOneTick = 1 << kFracBits;
+
+// Runs the core ISR tick by tick against a clock with a period that is not a
+// multiple of the tick: edges are "interrupts" with the cycle counter set to
+// the edge time, scans happen at the tick boundaries.
+class SimulatedInput {
+public:
+  SimulatedInput(EdgeTimestamp &timestamp, uint32_t start, uint32_t first_edge, uint32_t period)
+  : timestamp_(timestamp)
+  , now_(start)
+  , next_edge_(first_edge)
+  , period_(period)
+  , last_edge_(0) {
+    timestamp_.Init();
+  }
+
+  // @return true if clocked this tick
+  bool Tick() {
+    const uint32_t tick_end = now_ + kCyclesPerTick;
+    while (static_cast<int32_t>(tick_end - next_edge_) >= 0) {
+      util::HostCycleCounter::value() = next_edge_;
+      timestamp_.Edge(util::cycle_count());
+      last_edge_ = next_edge_;
+      next_edge_ += period_;
+    }
+    now_ = tick_end;
+    util::HostCycleCounter::value() = now_;
+    return timestamp_.Scan(util::cycle_count());
+  }
+
+  uint32_t now() const { return now_; }
+  uint32_t last_edge() const { return last_edge_; }
+
+private:
+  EdgeTimestamp &timestamp_;
+  uint32_t now_;
+  uint32_t next_edge_;
+  uint32_t period_;
+  uint32_t last_edge_;
+};
+
+TEST(EdgeTimestampTest, CyclesToTicks) {
+  EXPECT_EQ(0U, EdgeTimestamp::cycles_to_ticks(0));
+  EXPECT_EQ(kOneTick, EdgeTimestamp::cycles_to_ticks(kCyclesPerTick));
+  EXPECT_EQ(kOneTick / 2, EdgeTimestamp::cycles_to_ticks(kCyclesPerTick / 2));
+  EXPECT_EQ(1000 * kOneTick, EdgeTimestamp::cycles_to_ticks(1000 * kCyclesPerTick));
+  EXPECT_EQ(kOneTick - 1, EdgeTimestamp::cycles_to_ticks(kCyclesPerTick - 1));
+}
+
+TEST(EdgeTimestampTest, PeriodAndAge) {
+  // 37.33 ticks
+  const uint32_t period = 37 * kCyclesPerTick + kCyclesPerTick / 3;
+  for (uint32_t start : { 0U, 0xffffffffU - 100 * kCyclesPerTick }) {
+    EdgeTimestamp timestamp;
+    SimulatedInput input(timestamp, start, start + 1234, period);
+    uint32_t edges = 0;
+    for (int tick = 0; tick < 2000; ++tick) {
+      if (!input.Tick())
+        continue;
+
+      EXPECT_EQ(input.last_edge(), timestamp.cycles());
+      EXPECT_LT(timestamp.age(), kOneTick);
+      EXPECT_EQ(EdgeTimestamp::cycles_to_ticks(input.now() - input.last_edge()), timestamp.age());
+      if (edges++) {
+        EXPECT_EQ(EdgeTimestamp::cycles_to_ticks(period), timestamp.period()) << "start=" << start;
+      } else {
+        EXPECT_EQ(0U, timestamp.period()) << "No period from first edge";
+      }
+    }
+    EXPECT_EQ((2000 * kCyclesPerTick - 1234) / period + 1, edges);
+  }
+}
+
+TEST(EdgeTimestampTest, SeveralEdgesPerTick) {
+  // 0.4 ticks, so two or three edges per scan
+  const uint32_t period = kCyclesPerTick * 2 / 5;
+  EdgeTimestamp timestamp;
+  SimulatedInput input(timestamp, 0, 100, period);
+  for (int tick = 0; tick < 100; ++tick) {
+    EXPECT_TRUE(input.Tick());
+    if (tick) {
+      EXPECT_NEAR(EdgeTimestamp::cycles_to_ticks(period), timestamp.period(), 1);
+    }
+  }
+}
+
+// Clock x n as HEM_ClockDivider: sync on input clock, then multiplied clocks
+// every period / n. Returns the tick of each output.
+template <bool precise>
+std::vector<uint32_t> multiply(uint32_t period, int n, int ticks) {
+  EdgeTimestamp timestamp;
+  SimulatedInput input(timestamp, 0, 500, period);
+  std::vector<uint32_t> outputs;
+  uint32_t last_clock = 0, cycle_ticks = 0;
+  int32_t next_clock = 0, clock_every = 0, count = 0;
+
+  for (int tick = 0; tick < ticks; ++tick) {
+    if (input.Tick()) {
+      cycle_ticks = tick - last_clock;
+      last_clock = tick;
+      if (precise) {
+        uint32_t period_ticks = timestamp.period() ? timestamp.period() : cycle_ticks << kFracBits;
+        clock_every = period_ticks / n;
+        next_clock = clock_every - timestamp.age();
+        count = 1;
+      } else {
+        clock_every = cycle_ticks / n;
+        next_clock = tick + clock_every;
+      }
+      outputs.push_back(tick);
+    }
+
+    if (precise) {
+      if (next_clock <= 0 && count < n) {
+        next_clock += clock_every;
+        ++count;
+        outputs.push_back(tick);
+      }
+      next_clock -= kOneTick;
+    } else if (tick >= next_clock) {
+      next_clock += clock_every;
+      outputs.push_back(tick);
+    }
+  }
+  return outputs;
+}
+
+TEST(EdgeTimestampTest, MultipliedClockJitter) {
+  for (int n : { 3, 5 }) {
+    // 100.45 ticks
+    const uint32_t period = 100 * kCyclesPerTick + kCyclesPerTick * 9 / 20;
+    const double interval = 100.45 / n;
+
+    // Skip the first clocks, which don't have a period yet
+    auto max_jitter = [&](const std::vector<uint32_t> &outputs) {
+      double jitter = 0;
+      for (size_t i = 1; i < outputs.size(); ++i) {
+        if (outputs[i - 1] < 1000) continue;
+        double error = std::fabs((outputs[i] - outputs[i - 1]) - interval);
+        if (error > jitter) jitter = error;
+      }
+      return jitter;
+    };
+
+    std::vector<uint32_t> precise = multiply<true>(period, n, 20000);
+    std::vector<uint32_t> ticks = multiply<false>(period, n, 20000);
+
+    // n outputs per input clock, the last clock's cycle may be incomplete
+    const size_t clocks = (20000 * kCyclesPerTick - 500) / period + 1;
+    EXPECT_LE(precise.size(), clocks * n);
+    EXPECT_GT(precise.size(), (clocks - 1) * n);
+    EXPECT_LT(max_jitter(precise), 1.0) << "n=" << n;
+    EXPECT_GT(max_jitter(ticks), max_jitter(precise)) << "n=" << n;
+  }
+}
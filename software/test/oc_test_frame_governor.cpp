@@ -0,0 +1,66 @@
+#include "gtest/gtest.h"
+#include "util/util_frame_governor.h"
+
+// Main loop that takes loop_us per iteration and draw_us extra per frame
+struct LoopResult {
+  uint32_t frames;
+  uint32_t max_gap;
+};
+
+static LoopResult run(util::FrameGovernor &governor, uint32_t start, uint32_t duration,
+                      uint32_t loop_us, uint32_t draw_us, uint32_t load) {
+  LoopResult result = { 0, 0 };
+  uint32_t now = start, last_frame = start;
+  while (now - start < duration) {
+    if (governor.Due(now, load)) {
+      now += draw_us;
+      governor.Drawn(now);
+      if (result.frames++ && now - last_frame > result.max_gap)
+        result.max_gap = now - last_frame;
+      last_frame = now;
+    }
+    now += loop_us;
+  }
+  return result;
+}
+
+TEST(FrameGovernorTest, TargetFps) {
+  for (uint32_t start : { 0U, 0xffffffffU - 500000 }) {
+    util::FrameGovernor governor;
+    governor.Init(50, 80);
+    LoopResult result = run(governor, start, 2000000, 100, 2000, 10);
+    EXPECT_NEAR(100, result.frames, 2) << start;
+    EXPECT_LT(result.max_gap, 20000 + 2100U);
+    EXPECT_NEAR(50, governor.fps(), 1);
+    EXPECT_EQ(0U, governor.dropped_frames());
+  }
+}
+
+TEST(FrameGovernorTest, DropsFramesUnderLoad) {
+  util::FrameGovernor governor;
+  governor.Init(50, 80);
+  LoopResult result = run(governor, 0, 2000000, 100, 2000, 90);
+
+  // Only every kMaxDroppedFrames + 1 due frames is drawn
+  const uint32_t period = 20000 * (util::FrameGovernor::kMaxDroppedFrames + 1);
+  EXPECT_NEAR(2000000 / period, result.frames, 2);
+  EXPECT_LT(result.max_gap, period + 2100);
+  EXPECT_NEAR(result.frames * util::FrameGovernor::kMaxDroppedFrames, governor.dropped_frames(), 3);
+  EXPECT_NEAR(50 / (util::FrameGovernor::kMaxDroppedFrames + 1), governor.fps(), 1);
+}
+
+TEST(FrameGovernorTest, WakeDrawsImmediately) {
+  util::FrameGovernor governor;
+  governor.Init(10, 80);
+  EXPECT_TRUE(governor.Due(0, 0)) << "First frame";
+  governor.Drawn(0);
+  EXPECT_FALSE(governor.Due(1000, 0));
+
+  governor.Wake();
+  EXPECT_TRUE(governor.Due(1000, 100)) << "Even under load";
+  EXPECT_TRUE(governor.Due(1100, 100)) << "Until drawn";
+  governor.Drawn(1200);
+  EXPECT_FALSE(governor.Due(1300, 0));
+  EXPECT_TRUE(governor.Due(101200, 0));
+  EXPECT_EQ(0U, governor.dropped_frames());
+}
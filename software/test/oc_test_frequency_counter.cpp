@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "util/util_frequency_counter.h"
+
+#include <cmath>
+#include <random>
+
+static constexpr uint32_t kCyclesPerSecond = 120000000;
+static constexpr uint32_t kCyclesPerTick = 7200;
+typedef util::FrequencyCounter<kCyclesPerSecond> FrequencyCounter;
+
+// Same as OC::DigitalInputs
+static constexpr uint32_t kGateTime = kCyclesPerSecond / 20;
+static constexpr uint32_t kTimeout = kCyclesPerSecond;
+
+TEST(FrequencyCounterTest, Log2) {
+  EXPECT_EQ(0, util::log2_q16(1));
+  EXPECT_EQ(1 << 16, util::log2_q16(2));
+  EXPECT_EQ(31 << 16, util::log2_q16(0x80000000));
+  EXPECT_NEAR(std::log2(3.0) * 65536, util::log2_q16(3), 1);
+  EXPECT_NEAR(std::log2(440000.0) * 65536, util::log2_q16(440000), 1);
+  EXPECT_NEAR(std::log2(0xffffffff) * 65536, util::log2_q16(0xffffffff), 1);
+}
+
+TEST(FrequencyCounterTest, Cents) {
+  EXPECT_EQ(1200 << 8, util::frequency_cents(880000, 440000));
+  EXPECT_EQ(-2400 * 256, util::frequency_cents(110000, 440000));
+  // A#4, 100 cents
+  EXPECT_NEAR(100 << 8, util::frequency_cents(466164, 440000), 26);
+  // C0 is 57 semitones below A4
+  EXPECT_NEAR(-5700 * 256, util::frequency_cents(16352, 440000), 26);
+  EXPECT_EQ(0, util::frequency_cents(0, 440000));
+}
+
+// Edges in cycles at a given frequency, counter updated once per tick
+static uint32_t measure_edges(double hz, uint32_t start, uint32_t ticks) {
+  FrequencyCounter counter;
+  counter.Init(kGateTime, kTimeout);
+  const double period = kCyclesPerSecond / hz;
+  double next_edge = start + 1234.5;
+  for (uint32_t tick = 1; tick <= ticks; ++tick) {
+    const double now = start + static_cast<double>(tick) * kCyclesPerTick;
+    while (next_edge <= now) {
+      counter.Edge(static_cast<uint32_t>(static_cast<uint64_t>(next_edge)));
+      next_edge += period;
+    }
+    counter.Update(static_cast<uint32_t>(static_cast<uint64_t>(now)));
+  }
+  return counter.millihertz();
+}
+
+TEST(FrequencyCounterTest, DigitalEdges) {
+  EXPECT_EQ(0U, measure_edges(440.0, 0, 10));
+  EXPECT_NEAR(440000, measure_edges(440.0, 0, 16666), 1);
+  EXPECT_NEAR(261626, measure_edges(261.6256, 0, 16666), 1);
+  EXPECT_NEAR(4186009, measure_edges(4186.009, 0, 16666), 2);
+  EXPECT_NEAR(1500, measure_edges(1.5, 0, 16666 * 4), 1);
+  // Cycle counter wraps every ~36s
+  EXPECT_NEAR(440000, measure_edges(440.0, 0xffffffff - kCyclesPerSecond / 2, 16666), 1);
+}
+
+TEST(FrequencyCounterTest, Timeout) {
+  FrequencyCounter counter;
+  counter.Init(kGateTime, kTimeout);
+  for (uint32_t edge = 0; edge < 100; ++edge) {
+    counter.Edge(edge * kCyclesPerSecond / 100);
+    counter.Update(edge * kCyclesPerSecond / 100);
+  }
+  EXPECT_EQ(100000U, counter.millihertz());
+  EXPECT_FALSE(counter.Update(99 * kCyclesPerSecond / 100 + kTimeout));
+  EXPECT_TRUE(counter.Update(100 * kCyclesPerSecond / 100 + kTimeout));
+  EXPECT_EQ(0U, counter.millihertz());
+}
+
+TEST(FrequencyCounterTest, ZeroCrossingInterpolation) {
+  util::ZeroCrossingDetector detector;
+  detector.Init(64);
+  uint32_t crossing = 0;
+  EXPECT_FALSE(detector.Process(-100, 0, crossing));
+  EXPECT_FALSE(detector.Process(-300, 1000, crossing));
+  EXPECT_TRUE(detector.Process(100, 2000, crossing));
+  EXPECT_EQ(1750U, crossing);
+
+  // Large steps and wrapping times
+  EXPECT_FALSE(detector.Process(-100000, 0xffffff00, crossing));
+  EXPECT_TRUE(detector.Process(300000, 0x00000300, crossing));
+  EXPECT_EQ(0xffffff00U + 0x100, crossing);
+}
+
+TEST(FrequencyCounterTest, ZeroCrossings) {
+  // Sine into a CV input converted every 4 ticks (~4.2kHz), with some noise,
+  // timed from the conversion tick as OC::ADC
+  for (double hz : { 55.0, 220.0, 440.0, 1000.0 }) {
+    util::ZeroCrossingDetector detector;
+    detector.Init(64);
+    FrequencyCounter counter;
+    counter.Init(kCyclesPerSecond / 10, kTimeout);
+    std::mt19937 rng(0x5eed);
+    std::uniform_int_distribution<int> noise(-8, 8);
+
+    for (uint32_t tick = 0; tick < 16666 * 2; tick += 4) {
+      const uint32_t time = tick * kCyclesPerTick;
+      const double t = static_cast<double>(time) / kCyclesPerSecond;
+      const int32_t value = static_cast<int32_t>(3000 * std::sin(2 * M_PI * hz * t)) + noise(rng);
+      uint32_t crossing;
+      if (detector.Process(value, time, crossing))
+        counter.Edge(crossing);
+      counter.Update(time);
+    }
+    const double cents = util::frequency_cents(counter.millihertz(), hz * 1000) / 256.0;
+    EXPECT_LT(std::fabs(cents), 2.0) << hz << "Hz: " << counter.millihertz() << "mHz";
+  }
+}
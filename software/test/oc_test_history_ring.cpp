@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "util/util_history_ring.h"
+
+typedef util::HistoryRing<uint16_t, 16> HistoryRing;
+
+TEST(HistoryRingTest, Init) {
+  HistoryRing history;
+  history.Init(1234);
+  HistoryRing::View view = history.Snapshot();
+  EXPECT_EQ(16U, view.length);
+  for (size_t i = 0; i < view.length; ++i)
+    EXPECT_EQ(1234, view[i]);
+  EXPECT_EQ(0U, history.samples());
+}
+
+TEST(HistoryRingTest, OldestFirst) {
+  HistoryRing history;
+  history.Init(0);
+  for (uint16_t value = 1; value <= 40; ++value) {
+    EXPECT_TRUE(history.Push(value));
+
+    HistoryRing::View view = history.Snapshot();
+    EXPECT_EQ(value, view.last());
+    EXPECT_EQ(value, view[view.length - 1]);
+    for (size_t i = 0; i < view.length; ++i) {
+      int expected = value - (int)(view.length - 1 - i);
+      EXPECT_EQ(expected > 0 ? expected : 0, view[i]);
+    }
+  }
+  EXPECT_EQ(40U, history.samples());
+}
+
+TEST(HistoryRingTest, Decimation) {
+  HistoryRing history;
+  history.Init(0);
+  history.set_decimation(3);
+
+  uint32_t stored = 0;
+  for (uint32_t tick = 0; tick < 8 * 20; ++tick) {
+    // Values 0..7 average to 3 (truncated from 3.5), +100 per block
+    uint16_t value = (tick & 7) + 100 * (tick >> 3);
+    if (history.Push(value)) {
+      ++stored;
+      EXPECT_EQ(7U, tick & 7);
+      EXPECT_EQ(3 + 100 * (tick >> 3), history.Snapshot().last());
+    }
+  }
+  EXPECT_EQ(20U, stored);
+  EXPECT_EQ(20U, history.samples());
+}
+
+TEST(HistoryRingTest, MaxDecimation) {
+  HistoryRing history;
+  history.Init(0);
+  history.set_decimation(31);
+  const uint32_t max_decimation = HistoryRing::kMaxDecimation;
+  EXPECT_EQ(max_decimation, history.decimation());
+
+  // Full-scale values must not overflow the accumulator
+  for (uint32_t tick = 1; tick < (1U << max_decimation); ++tick)
+    EXPECT_FALSE(history.Push(65535));
+  EXPECT_TRUE(history.Push(65535));
+  EXPECT_EQ(65535, history.Snapshot().last());
+}
+
+TEST(HistoryRingTest, Hold) {
+  HistoryRing history;
+  history.Init(0);
+  history.Push(1);
+  history.set_hold(true);
+  EXPECT_FALSE(history.Push(2));
+  EXPECT_EQ(1, history.Snapshot().last());
+  EXPECT_EQ(1U, history.samples());
+  history.set_hold(false);
+  EXPECT_TRUE(history.Push(3));
+  EXPECT_EQ(3, history.Snapshot().last());
+}
+
+TEST(HistoryRingTest, SignedValues) {
+  util::HistoryRing<int16_t, 8> history;
+  history.Init(0);
+  history.set_decimation(1);
+  history.Push(-4096);
+  history.Push(-4095);
+  // Arithmetic shift rounds towards -inf, as the DAC/ADC shifts elsewhere
+  EXPECT_EQ(-4096, history.Snapshot().last());
+}
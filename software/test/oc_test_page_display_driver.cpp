@@ -0,0 +1,186 @@
+#include "gtest/gtest.h"
+
+#include <stdint.h>
+#include <string.h>
+#include "src/drivers/framebuffer.h"
+#include "src/drivers/page_display_driver.h"
+
+#include <random>
+#include <vector>
+
+// Records the pages sent instead of sending them via SPI
+struct MockDisplayDriver {
+  static constexpr size_t kNumPages = 8;
+  static constexpr size_t kPageSize = 128;
+  static constexpr size_t kFrameSize = kNumPages * kPageSize;
+
+  static std::vector<uint8_t> sent;
+  static uint32_t flushes;
+  static uint8_t panel[kFrameSize]; // Display contents
+
+  static void Init() { sent.clear(); }
+  static void SendPage(uint_fast8_t index, const uint8_t *data) {
+    sent.push_back(index);
+    memcpy(panel + index * kPageSize, data, kPageSize);
+  }
+  static void Flush() { ++flushes; }
+};
+
+std::vector<uint8_t> MockDisplayDriver::sent;
+uint32_t MockDisplayDriver::flushes;
+uint8_t MockDisplayDriver::panel[MockDisplayDriver::kFrameSize];
+
+typedef PagedDisplayDriver<MockDisplayDriver> Driver;
+typedef FrameBuffer<MockDisplayDriver::kFrameSize, 2, MockDisplayDriver::kNumPages> Frames;
+
+// Same order as the core ISR: Flush, Update. Returns the pages sent for the frame.
+static std::vector<uint8_t> send_frame(Driver &driver, Frames &frames, const uint8_t *contents) {
+  uint8_t *frame = frames.writeable_frame();
+  memcpy(frame, contents, Frames::kFrameSize);
+  Driver::HashPages(frame, frames.writeable_page_hashes());
+  frames.written();
+
+  MockDisplayDriver::sent.clear();
+  for (int tick = 0; tick < 20; ++tick) {
+    if (driver.Flush())
+      frames.read();
+    if (driver.frame_valid())
+      driver.Update();
+    else if (frames.readable())
+      driver.Begin(frames.readable_frame(), frames.readable_page_hashes());
+  }
+  return MockDisplayDriver::sent;
+}
+
+TEST(PageDisplayDriverTest, SkipsCleanPages) {
+  static Driver driver;
+  static Frames frames;
+  driver.Init();
+  frames.Init();
+
+  uint8_t contents[Frames::kFrameSize];
+  memset(contents, 0, sizeof(contents));
+
+  EXPECT_EQ(8U, send_frame(driver, frames, contents).size()) << "First frame is sent completely";
+  EXPECT_TRUE(send_frame(driver, frames, contents).empty());
+
+  contents[3 * 128 + 17] = 0x10;
+  contents[6 * 128 + 127] = 0x80;
+  std::vector<uint8_t> sent = send_frame(driver, frames, contents);
+  ASSERT_EQ(2U, sent.size());
+  EXPECT_EQ(3U, sent[0]);
+  EXPECT_EQ(6U, sent[1]);
+
+  EXPECT_TRUE(send_frame(driver, frames, contents).empty());
+
+  driver.Invalidate();
+  EXPECT_EQ(8U, send_frame(driver, frames, contents).size());
+}
+
+TEST(PageDisplayDriverTest, Suspend) {
+  static Driver driver;
+  static Frames frames;
+  driver.Init();
+  frames.Init();
+
+  uint8_t contents[Frames::kFrameSize];
+  memset(contents, 0xaa, sizeof(contents));
+  EXPECT_EQ(8U, send_frame(driver, frames, contents).size());
+
+  driver.Suspend();
+  MockDisplayDriver::flushes = 0;
+  const uint32_t sent = driver.pages_sent();
+  for (int f = 0; f < 4; ++f) {
+    contents[f * 128] = f;
+    EXPECT_TRUE(send_frame(driver, frames, contents).empty()) << "Frames are consumed";
+  }
+  EXPECT_EQ(0U, frames.readable());
+  EXPECT_EQ(0U, MockDisplayDriver::flushes) << "No transfers to finish";
+  EXPECT_EQ(sent, driver.pages_sent());
+  EXPECT_EQ(4U * 20, driver.suspended_ticks());
+
+  // The display still shows the frame from before, so all pages are sent
+  // even if they are the same
+  driver.Resume();
+  memset(contents, 0xaa, sizeof(contents));
+  EXPECT_EQ(8U, send_frame(driver, frames, contents).size());
+  EXPECT_EQ(8U, MockDisplayDriver::flushes);
+  EXPECT_EQ(sent + 8, driver.pages_sent());
+  EXPECT_TRUE(send_frame(driver, frames, contents).empty());
+}
+
+TEST(PageDisplayDriverTest, SkippedPagesPercent) {
+  static Driver driver;
+  static Frames frames;
+  driver.Init();
+  frames.Init();
+
+  // One page changes per frame
+  uint8_t contents[Frames::kFrameSize];
+  memset(contents, 0, sizeof(contents));
+  const uint32_t frame_count = Driver::kStatsWindow / Driver::kNumPages;
+  for (uint32_t f = 0; f < frame_count; ++f) {
+    contents[(f % 8) * 128] = f + 1;
+    send_frame(driver, frames, contents);
+  }
+  // All pages in the first frame, then 7/8 skipped
+  EXPECT_EQ((7 * (frame_count - 1) * 100) / (8 * frame_count), driver.skipped_pages_percent());
+}
+
+// Main loop drawing whenever a frame is writeable, with `ticks` core ISRs per
+// iteration. Every frame that reaches the display must look exactly as drawn,
+// in the order drawn; with fewer buffers some are just never drawn.
+template <size_t frames>
+static void check_displayed_frames(uint32_t ticks, uint32_t &drawn) {
+  typedef FrameBuffer<MockDisplayDriver::kFrameSize, frames, MockDisplayDriver::kNumPages> Buffers;
+  static Driver driver;
+  static Buffers buffers;
+  driver.Init();
+  buffers.Init();
+  memset(MockDisplayDriver::panel, 0, sizeof(MockDisplayDriver::panel));
+
+  std::mt19937 rng(0xd15b);
+  std::vector<std::vector<uint8_t>> rendered;
+  size_t displayed = 0;
+  for (uint32_t iteration = 0; iteration < 2000; ++iteration) {
+    if (buffers.writeable() && iteration < 1900) {
+      // Change a few pages, as when drawing a screen
+      std::vector<uint8_t> contents = rendered.empty() ? std::vector<uint8_t>(Buffers::kFrameSize, 0) : rendered.back();
+      for (int change = rng() % 3; change >= 0; --change)
+        contents[rng() % Buffers::kFrameSize] = rng();
+      uint8_t *frame = buffers.writeable_frame();
+      memcpy(frame, contents.data(), Buffers::kFrameSize);
+      Driver::HashPages(frame, buffers.writeable_page_hashes());
+      buffers.written();
+      rendered.push_back(contents);
+    }
+
+    for (uint32_t tick = 0; tick < ticks; ++tick) {
+      if (driver.frame_valid() && driver.Flush()) {
+        buffers.read();
+        ASSERT_LT(displayed, rendered.size());
+        ASSERT_EQ(0, memcmp(rendered[displayed].data(), MockDisplayDriver::panel, Buffers::kFrameSize))
+            << "frames=" << frames << " frame " << displayed;
+        ++displayed;
+      }
+      if (driver.frame_valid())
+        driver.Update();
+      else if (buffers.readable())
+        driver.Begin(buffers.readable_frame(), buffers.readable_page_hashes());
+    }
+  }
+  EXPECT_EQ(rendered.size(), displayed) << "frames=" << frames;
+  drawn = rendered.size();
+}
+
+TEST(PageDisplayDriverTest, SingleBuffer) {
+  for (uint32_t ticks : { 1U, 3U, 20U }) {
+    uint32_t double_buffered, single_buffered;
+    check_displayed_frames<2>(ticks, double_buffered);
+    check_displayed_frames<1>(ticks, single_buffered);
+    EXPECT_LE(single_buffered, double_buffered) << ticks;
+    if (ticks >= 2 * MockDisplayDriver::kNumPages) {
+      EXPECT_EQ(single_buffered, double_buffered) << "Transfer done between iterations";
+    }
+  }
+}
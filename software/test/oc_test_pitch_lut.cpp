@@ -0,0 +1,118 @@
+#include "gtest/gtest.h"
+#include "util/util_pitch_lut.h"
+
+#include <random>
+
+static constexpr size_t kOctaves = 10;
+static constexpr int32_t kOctaveZero = 3;
+typedef util::PitchLUT<kOctaves> PitchLUT;
+
+// Original OC::DAC::pitch_to_dac/pitch_to_scaled_voltage_dac as reference
+static int32_t ref_lookup(const uint16_t *calibrated_octaves, int32_t pitch) {
+  if (pitch < 0) pitch = 0;
+  else if (pitch > (120 << 7)) pitch = 120 << 7;
+
+  const int32_t octave = pitch / (12 << 7);
+  const int32_t fractional = pitch - octave * (12 << 7);
+
+  int32_t sample = calibrated_octaves[octave];
+  if (fractional) {
+    int32_t span = calibrated_octaves[octave + 1] - sample;
+    sample += (fractional * span) / (12 << 7);
+  }
+  return sample;
+}
+
+static int32_t ref_scale(int32_t pitch, int voltage_scaling) {
+  switch (voltage_scaling) {
+    case 0: break;
+    case 1: pitch = (pitch * 25548) >> 15; break;
+    case 2: pitch = (pitch * 20917) >> 15; break;
+    case 3: pitch = (pitch * 11501) >> 15; break;
+    case 4: pitch = (pitch * 25969) >> 14; break;
+    case 5: pitch = pitch >> 1; break;
+    case 6: pitch = (pitch * 19661) >> 14; break;
+    case 7: pitch = pitch << 1; break;
+    default: break;
+  }
+  return pitch;
+}
+
+// Same values as OC::DAC::kVoltageScalings (incl. BUCHLA_SUPPORT)
+static const util::PitchScaling kVoltageScalings[] = {
+  { 1, 0 }, { 25548, 15 }, { 20917, 15 }, { 11501, 15 }, { 25969, 14 }, { 1, 1 }, { 19661, 14 }, { 2, 0 }
+};
+
+class PitchLUTTest : public ::testing::Test {
+public:
+  virtual void SetUp() {
+    rng_.seed(0x1234);
+  }
+
+protected:
+  void default_calibration(uint16_t *calibrated_octaves) {
+    // Roughly what the calibration defaults look like (inverted DAC is handled elsewhere)
+    for (size_t i = 0; i <= kOctaves; ++i)
+      calibrated_octaves[i] = 197 + i * 6425;
+  }
+
+  void random_calibration(uint16_t *calibrated_octaves) {
+    for (size_t i = 0; i <= kOctaves; ++i)
+      calibrated_octaves[i] = rng_() & 0xffff;
+  }
+
+  void verify(const uint16_t *calibrated_octaves) {
+    PitchLUT lut;
+    lut.Init(calibrated_octaves);
+    for (int32_t pitch = -(12 << 7); pitch <= (132 << 7); ++pitch)
+      ASSERT_EQ(ref_lookup(calibrated_octaves, pitch), lut.lookup(pitch)) << "pitch=" << pitch;
+  }
+
+  std::mt19937 rng_;
+};
+
+TEST_F(PitchLUTTest, OctaveUnits) {
+  for (uint32_t n = 0; n < 1536 * 65536; n += 7)
+    ASSERT_EQ(n / 1536, PitchLUT::div_octave_units(n));
+  ASSERT_EQ(1535U * 65535U / 1536, PitchLUT::div_octave_units(1535U * 65535U));
+}
+
+TEST_F(PitchLUTTest, DefaultCalibration) {
+  uint16_t calibrated_octaves[kOctaves + 1];
+  default_calibration(calibrated_octaves);
+  verify(calibrated_octaves);
+}
+
+TEST_F(PitchLUTTest, RandomCalibration) {
+  // Includes non-monotonic tables, i.e. negative spans
+  uint16_t calibrated_octaves[kOctaves + 1];
+  for (int i = 0; i < 32; ++i) {
+    random_calibration(calibrated_octaves);
+    verify(calibrated_octaves);
+  }
+}
+
+TEST_F(PitchLUTTest, ExtremeCalibration) {
+  uint16_t calibrated_octaves[kOctaves + 1];
+  for (size_t i = 0; i <= kOctaves; ++i)
+    calibrated_octaves[i] = (i & 1) ? 0xffff : 0;
+  verify(calibrated_octaves);
+}
+
+TEST_F(PitchLUTTest, VoltageScaling) {
+  uint16_t calibrated_octaves[kOctaves + 1];
+  default_calibration(calibrated_octaves);
+  PitchLUT lut;
+  lut.Init(calibrated_octaves);
+
+  for (int scaling = 0; scaling < 8; ++scaling) {
+    for (int32_t octave_offset = -4; octave_offset <= 4; ++octave_offset) {
+      for (int32_t pitch = -(60 << 7); pitch <= (60 << 7); ++pitch) {
+        int32_t p = pitch + ((octave_offset * 12) << 7);
+        int32_t expected = ref_lookup(calibrated_octaves, ref_scale(p, scaling) + ((kOctaveZero * 12) << 7));
+        int32_t actual = lut.lookup(kVoltageScalings[scaling].scale(p) + ((kOctaveZero * 12) << 7));
+        ASSERT_EQ(expected, actual) << "scaling=" << scaling << " pitch=" << p;
+      }
+    }
+  }
+}
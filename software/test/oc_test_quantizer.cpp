@@ -39,3 +39,22 @@ TEST_F(QuantizerTest, SingleNote) {
   EXPECT_EQ(0, quantizer_.Process(-128));
   EXPECT_EQ(0, quantizer_.Process(-kOctave/2));
 }
+
+// Transposing the last quantized note by codebook index is the same as
+// quantizing with transpose (Squanch relies on this)
+TEST_F(QuantizerTest, TransposeNoteNumber) {
+  braids::Quantizer transposed;
+  transposed.Init();
+  quantizer_.Configure(braids::scales[2]);
+  transposed.Configure(braids::scales[2]);
+
+  for (int32_t transpose : { -7, -1, 1, 3, 12 }) {
+    for (int32_t pitch = -3 * kOctave; pitch < 3 * kOctave; pitch += 37) {
+      const int32_t quantized = quantizer_.Process(pitch, 0, 0);
+      const int32_t note = quantizer_.note_number();
+      EXPECT_EQ(transposed.Process(pitch, 0, transpose),
+                quantized + quantizer_.Lookup(note + transpose) - quantizer_.Lookup(note))
+          << pitch << " " << transpose;
+    }
+  }
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include "util/util_simd2.h"
+
+#include <random>
+
+namespace simd2 = util::simd2;
+
+// Scalar reference of the M4 instruction semantics, lane by lane; the host
+// build uses the portable backend, which has to match bit-for-bit.
+static int32_t ref_saturate16(int32_t value) {
+  if (value > 32767) return 32767;
+  if (value < -32768) return -32768;
+  return value;
+}
+
+class Simd2Test : public ::testing::Test {
+public:
+  virtual void SetUp() {
+    rng_.seed(0x5eed);
+  }
+
+protected:
+  int16_t random_value() {
+    // Bias towards the extremes to cover the saturation/wrap cases
+    switch (rng_() % 8) {
+      case 0: return 32767;
+      case 1: return -32768;
+      default: return (int16_t)(rng_() & 0xffff);
+    }
+  }
+
+  std::mt19937 rng_;
+};
+
+TEST_F(Simd2Test, PackUnpack) {
+  simd2::int16x2 v = simd2::pack(-1, 7680);
+  EXPECT_EQ(-1, simd2::lo(v));
+  EXPECT_EQ(7680, simd2::hi(v));
+  EXPECT_EQ(-1, simd2::lane(v, 0));
+  EXPECT_EQ(7680, simd2::lane(v, 1));
+  EXPECT_EQ(simd2::pack(-4608, -4608), simd2::splat(-4608));
+}
+
+TEST_F(Simd2Test, AddSub) {
+  for (int i = 0; i < 10000; ++i) {
+    int16_t a0 = random_value(), a1 = random_value();
+    int16_t b0 = random_value(), b1 = random_value();
+    simd2::int16x2 a = simd2::pack(a0, a1);
+    simd2::int16x2 b = simd2::pack(b0, b1);
+
+    EXPECT_EQ(simd2::pack((int16_t)(a0 + b0), (int16_t)(a1 + b1)), simd2::add(a, b));
+    EXPECT_EQ(simd2::pack((int16_t)(a0 - b0), (int16_t)(a1 - b1)), simd2::sub(a, b));
+    EXPECT_EQ(simd2::pack(ref_saturate16(a0 + b0), ref_saturate16(a1 + b1)), simd2::qadd(a, b));
+    EXPECT_EQ(simd2::pack(ref_saturate16(a0 - b0), ref_saturate16(a1 - b1)), simd2::qsub(a, b));
+  }
+}
+
+TEST_F(Simd2Test, MultiplyAdd) {
+  for (int i = 0; i < 10000; ++i) {
+    int16_t a0 = random_value(), a1 = random_value();
+    int16_t b0 = random_value(), b1 = random_value();
+    int32_t acc = (int32_t)rng_();
+    simd2::int16x2 a = simd2::pack(a0, a1);
+    simd2::int16x2 b = simd2::pack(b0, b1);
+
+    int64_t dot = (int64_t)a0 * b0 + (int64_t)a1 * b1;
+    int64_t dotx = (int64_t)a0 * b1 + (int64_t)a1 * b0;
+    EXPECT_EQ((int32_t)(uint32_t)dot, simd2::dot(a, b));
+    EXPECT_EQ((int32_t)(uint32_t)dotx, simd2::dotx(a, b));
+    EXPECT_EQ((int32_t)(uint32_t)(acc + dot), simd2::dot_acc(acc, a, b));
+
+    EXPECT_EQ(simd2::pack((a0 * b0) >> 14, (a1 * b1) >> 14), simd2::mul_shift<14>(a, b));
+  }
+}
+
+TEST_F(Simd2Test, Clamp) {
+  const simd2::int16x2 min_value = simd2::splat(-4608);
+  const simd2::int16x2 max_value = simd2::splat(7680);
+  for (int i = 0; i < 10000; ++i) {
+    int16_t v0 = random_value(), v1 = random_value();
+    int32_t c0 = v0 < -4608 ? -4608 : (v0 > 7680 ? 7680 : v0);
+    int32_t c1 = v1 < -4608 ? -4608 : (v1 > 7680 ? 7680 : v1);
+    EXPECT_EQ(simd2::pack(c0, c1), simd2::clamp(simd2::pack(v0, v1), min_value, max_value));
+  }
+}
+
+// The applet kernels: Mixer:Bal and AttenOff vs. their original scalar code
+TEST_F(Simd2Test, MixerBalance) {
+  for (int balance = 0; balance <= 255; ++balance) {
+    simd2::int16x2 weights = simd2::pack(((255 - balance) << 14) / 255, (balance << 14) / 255);
+    for (int i = 0; i < 100; ++i) {
+      int s1 = (int)(rng_() % 15360) - 7680;
+      int s2 = (int)(rng_() % 15360) - 7680;
+      simd2::int16x2 signals = simd2::pack(s1, s2);
+      int mix1 = ((((255 - balance) << 14) / 255) * s1 + ((balance << 14) / 255) * s2) >> 14;
+      int mix2 = ((((255 - balance) << 14) / 255) * s2 + ((balance << 14) / 255) * s1) >> 14;
+      EXPECT_EQ(mix1, simd2::dot(weights, signals) >> 14);
+      EXPECT_EQ(mix2, simd2::dotx(weights, signals) >> 14);
+    }
+  }
+}
+
+TEST_F(Simd2Test, AttenuateOffset) {
+  for (int level = 0; level <= 63; ++level) {
+    int offset = level - 32;
+    simd2::int16x2 gain = simd2::splat((level << 14) / 63);
+    for (int i = 0; i < 100; ++i) {
+      int in = (int)(rng_() % 15360) - 7680;
+      int expected = ((((level << 14) / 63) * in) >> 14) + offset * 128;
+      if (expected < -4608) expected = -4608;
+      if (expected > 7680) expected = 7680;
+
+      simd2::int16x2 signal = simd2::mul_shift<14>(gain, simd2::splat(in));
+      signal = simd2::qadd(signal, simd2::splat(offset * 128));
+      signal = simd2::clamp(signal, simd2::splat(-4608), simd2::splat(7680));
+      EXPECT_EQ(expected, simd2::lo(signal));
+      EXPECT_EQ(expected, simd2::hi(signal));
+    }
+  }
+}
@@ -0,0 +1,551 @@
+#include "gtest/gtest.h"
+#include "src/drivers/weegfx.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <stdio.h>
+#include <vector>
+
+#define PROGMEM
+#include "extern/gfx_font_6x8.h"
+
+using weegfx::coord_t;
+static constexpr coord_t kWidth = weegfx::Graphics::kWidth;
+static constexpr coord_t kHeight = weegfx::Graphics::kHeight;
+static constexpr size_t kFrameSize = weegfx::Graphics::kFrameSize;
+static const int32_t kPow10[] = { 1, 10, 100, 1000 };
+
+// Byte-wise reference, i.e. the previous weegfx implementation
+namespace reference {
+
+enum Mode { NORMAL, INVERSE, CLEAR };
+
+static void pixel_row(uint8_t *dst, coord_t count, uint8_t mask, Mode mode) {
+  while (count-- > 0) {
+    switch (mode) {
+      case NORMAL: *dst++ |= mask; break;
+      case INVERSE: *dst++ ^= mask; break;
+      case CLEAR: *dst++ &= ~mask; break;
+    }
+  }
+}
+
+static void rect(uint8_t *frame, coord_t x, coord_t y, coord_t w, coord_t h, Mode mode) {
+  if (x + w > kWidth) w = kWidth - x;
+  if (x < 0) { w += x; x = 0; }
+  if (w <= 0) return;
+  if (y + h > kHeight) h = kHeight - y;
+  if (y < 0) { h += y; y = 0; }
+  if (h <= 0) return;
+
+  uint8_t *buf = frame + (y >> 3) * kWidth + x;
+  coord_t remainder = y & 0x7;
+  if (remainder) {
+    remainder = 8 - remainder;
+    uint8_t mask = ~(0xff >> remainder);
+    if (h < remainder) {
+      mask &= (0xff >> (remainder - h));
+      h = 0;
+    } else {
+      h -= remainder;
+    }
+    pixel_row(buf, w, mask, mode);
+    buf += kWidth;
+  }
+  remainder = h & 0x7;
+  h >>= 3;
+  while (h--) {
+    pixel_row(buf, w, 0xff, mode);
+    buf += kWidth;
+  }
+  if (remainder)
+    pixel_row(buf, w, ~(0xff << remainder), mode);
+}
+
+static void hline(uint8_t *frame, coord_t x, coord_t y, coord_t w) {
+  if (x + w > kWidth) w = kWidth - x;
+  if (x < 0) { w += x; x = 0; }
+  if (w <= 0 || y < 0 || y >= kHeight) return;
+  pixel_row(frame + (y >> 3) * kWidth + x, w, 0x1 << (y & 0x7), NORMAL);
+}
+
+static void bitmap8(uint8_t *frame, coord_t x, coord_t y, coord_t w, const uint8_t *data) {
+  if (x + w > kWidth) w = kWidth - x;
+  if (x < 0) {
+    w += x;
+    data -= x;
+    x = 0;
+  }
+  if (w <= 0) return;
+  coord_t h = 8;
+  if (y + h > kHeight) h = kHeight - y;
+  if (y < 0) { h += y; y = 0; }
+  if (h <= 0) return;
+
+  uint8_t *buf = frame + (y >> 3) * kWidth + x;
+  coord_t remainder = y & 0x7;
+  for (coord_t i = 0; i < w; ++i)
+    buf[i] |= data[i] << remainder;
+  if (remainder && h >= 8) {
+    for (coord_t i = 0; i < w; ++i)
+      buf[kWidth + i] |= data[i] >> (8 - remainder);
+  }
+}
+
+// Glyphs are clipped per pixel, so unlike bitmap8, y < 0 shows the bottom
+// rows
+static void glyph(uint8_t *frame, coord_t x, coord_t y, const uint8_t *data) {
+  for (coord_t i = 0; i < 6; ++i) {
+    for (coord_t row = 0; row < 8; ++row) {
+      const coord_t px = x + i, py = y + row;
+      if ((data[i] & (1 << row)) && px >= 0 && px < kWidth && py >= 0 && py < kHeight)
+        frame[(py >> 3) * kWidth + px] |= 1 << (py & 0x7);
+    }
+  }
+}
+
+static void text(uint8_t *frame, coord_t x, coord_t y, const char *s) {
+  for (; *s; ++s, x += 6)
+    glyph(frame, x, y, ssd1306xled_font6x8 + 6 * (*s - 32));
+}
+
+}; // namespace reference
+
+struct Primitive {
+  enum Type { RECT, CLEAR_RECT, INVERT_RECT, HLINE, BITMAP, TEXT, TYPES } type;
+  coord_t x, y, w, h;
+};
+
+static const uint8_t kBitmap[kWidth] = {
+  0x81, 0x42, 0x24, 0x18, 0xff, 0x00, 0xa5, 0x5a, 0x3c, 0xc3, 0x0f, 0xf0, 0x11, 0x88
+};
+static const char kText[] = "Hemisphere 0123456789 ABC xyz +-*/";
+
+static Primitive random_primitive(std::mt19937 &rng) {
+  Primitive p;
+  p.type = static_cast<Primitive::Type>(rng() % Primitive::TYPES);
+  switch (p.type) {
+    case Primitive::BITMAP:
+      p.x = static_cast<coord_t>(rng() % (kWidth + 8)) - 8;
+      p.y = static_cast<coord_t>(rng() % (kHeight + 8)) - 8;
+      p.w = 1 + rng() % 14;
+      break;
+    case Primitive::TEXT:
+      p.x = static_cast<coord_t>(rng() % (kWidth + 8)) - 8;
+      // Mostly page-aligned, as in the menus
+      p.y = rng() & 1 ? (rng() % 8) * 8 : static_cast<coord_t>(rng() % (kHeight + 8)) - 8;
+      p.w = 1 + rng() % 14;
+      break;
+    default:
+      p.x = static_cast<coord_t>(rng() % (kWidth + 16)) - 8;
+      p.y = static_cast<coord_t>(rng() % (kHeight + 16)) - 8;
+      p.w = rng() % (kWidth + 8);
+      break;
+  }
+  p.h = rng() % (kHeight + 8);
+  return p;
+}
+
+static void draw(weegfx::Graphics &graphics, const Primitive &p) {
+  switch (p.type) {
+    case Primitive::RECT: graphics.drawRect(p.x, p.y, p.w, p.h); break;
+    case Primitive::CLEAR_RECT: graphics.clearRect(p.x, p.y, p.w, p.h); break;
+    case Primitive::INVERT_RECT: graphics.invertRect(p.x, p.y, p.w, p.h); break;
+    case Primitive::HLINE: graphics.drawHLine(p.x, p.y, p.w); break;
+    case Primitive::BITMAP: graphics.drawBitmap8(p.x, p.y, p.w, kBitmap); break;
+    case Primitive::TEXT: graphics.drawStr(p.x, p.y, kText + sizeof(kText) - 1 - p.w); break;
+    default: break;
+  }
+}
+
+static void draw_reference(uint8_t *frame, const Primitive &p) {
+  switch (p.type) {
+    case Primitive::RECT: reference::rect(frame, p.x, p.y, p.w, p.h, reference::NORMAL); break;
+    case Primitive::CLEAR_RECT: reference::rect(frame, p.x, p.y, p.w, p.h, reference::CLEAR); break;
+    case Primitive::INVERT_RECT: reference::rect(frame, p.x, p.y, p.w, p.h, reference::INVERSE); break;
+    case Primitive::HLINE: reference::hline(frame, p.x, p.y, p.w); break;
+    case Primitive::BITMAP: reference::bitmap8(frame, p.x, p.y, p.w, kBitmap); break;
+    case Primitive::TEXT: reference::text(frame, p.x, p.y, kText + sizeof(kText) - 1 - p.w); break;
+    default: break;
+  }
+}
+
+struct Frame {
+  uint8_t data[kFrameSize] __attribute__((aligned(4)));
+};
+
+TEST(WeegfxTest, MatchesBytewiseReference) {
+  std::mt19937 rng(0x6f5c);
+  Frame frame, expected;
+  weegfx::Graphics graphics;
+  graphics.Init();
+
+  for (int f = 0; f < 200; ++f) {
+    graphics.Begin(frame.data, true);
+    memset(expected.data, 0, kFrameSize);
+    for (int i = 0; i < 50; ++i) {
+      Primitive p = random_primitive(rng);
+      draw(graphics, p);
+      draw_reference(expected.data, p);
+      ASSERT_EQ(0, memcmp(expected.data, frame.data, kFrameSize))
+          << "type=" << p.type << " x=" << p.x << " y=" << p.y << " w=" << p.w << " h=" << p.h;
+    }
+    graphics.End();
+  }
+}
+
+TEST(WeegfxTest, PrintInverse) {
+  Frame frame, expected;
+  weegfx::Graphics graphics;
+  graphics.Init();
+  for (coord_t y : { -7, -3, 0, 8, 13, 56, 60 }) {
+    for (coord_t x : { -5, 0, 3, 100, 125 }) {
+      // Inverse on empty frame is the same as normal text
+      graphics.Begin(frame.data, true);
+      graphics.setPrintPos(x, y);
+      graphics.print_inverse("Ab#");
+      graphics.End();
+      memset(expected.data, 0, kFrameSize);
+      reference::text(expected.data, x, y, "Ab#");
+      EXPECT_EQ(0, memcmp(expected.data, frame.data, kFrameSize)) << x << "," << y;
+
+      // Text on filled background
+      graphics.Begin(frame.data, false);
+      graphics.drawRect(0, 0, kWidth, kHeight);
+      graphics.setPrintPos(x, y);
+      graphics.print_inverse("Ab#");
+      graphics.setPrintPos(x, y);
+      graphics.print("Ab#");
+      graphics.End();
+      for (size_t i = 0; i < kFrameSize; ++i)
+        ASSERT_EQ(0xff, frame.data[i]) << x << "," << y;
+    }
+  }
+}
+
+TEST(WeegfxTest, PreshiftedBitmap) {
+  weegfx::PreshiftedBitmap8<8> icon;
+  icon.Init(kBitmap);
+  weegfx::PreshiftedBitmap8<5> narrow;
+  narrow.Init(kBitmap + 3);
+  // Other offsets fall back to the original data
+  weegfx::PreshiftedBitmap8<6, 0x82> two_shifts;
+  two_shifts.Init(kBitmap + 1);
+  EXPECT_GT(sizeof(narrow), sizeof(two_shifts));
+
+  weegfx::Graphics graphics;
+  graphics.Init();
+  Frame frame, expected;
+  for (coord_t y = -8; y <= kHeight; ++y) {
+    for (coord_t x = -9; x <= kWidth; ++x) {
+      graphics.Begin(frame.data, true);
+      graphics.drawBitmap8(x, y, icon);
+      graphics.drawBitmap8(x + 2, y + 3, narrow);
+      graphics.drawBitmap8(x + 5, y - 2, two_shifts);
+      graphics.End();
+      memset(expected.data, 0, kFrameSize);
+      reference::bitmap8(expected.data, x, y, 8, kBitmap);
+      reference::bitmap8(expected.data, x + 2, y + 3, 5, kBitmap + 3);
+      reference::bitmap8(expected.data, x + 5, y - 2, 6, kBitmap + 1);
+      ASSERT_EQ(0, memcmp(expected.data, frame.data, kFrameSize)) << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+TEST(WeegfxTest, CopyColumns) {
+  Frame previous, frame;
+  for (size_t i = 0; i < kFrameSize; ++i)
+    previous.data[i] = i * 7;
+
+  weegfx::Graphics graphics;
+  graphics.Init();
+  graphics.Begin(frame.data, true);
+  graphics.copyColumns(previous.data, 64, 64);
+  graphics.copyColumns(previous.data, -2, 4);
+  graphics.End();
+  for (size_t i = 0; i < kFrameSize; ++i) {
+    const size_t x = i % kWidth;
+    EXPECT_EQ(x >= 64 || x < 2 ? previous.data[i] : 0, frame.data[i]) << i;
+  }
+}
+
+// Static parts of some app screens, as drawn by their DrawChrome()
+static void header(weegfx::Graphics &graphics, const char *str) {
+  graphics.setPrintPos(1, 2);
+  graphics.print(str);
+  graphics.drawLine(0, 10, 127, 10);
+  graphics.drawLine(0, 12, 127, 12);
+}
+
+static void enigma_chrome(weegfx::Graphics &graphics) {
+  header(graphics, "Enigma - ");
+  graphics.print("Assign");
+  graphics.drawStr(0, 15, "Output");
+  graphics.drawFrame(0, 23, 48, 40);
+  for (coord_t line = 0; line < 3; ++line)
+    graphics.drawLine(0, 32 + (10 * line), 47, 32 + (10 * line));
+  graphics.drawLine(48, 23, 127, 23);
+}
+
+static void midi_chrome(weegfx::Graphics &graphics) {
+  header(graphics, "");
+  graphics.print("MIDI Channel");
+  graphics.setPrintPos(128 - 42, 1);
+  graphics.print("Setup ");
+  graphics.print(3);
+}
+
+static void setup_chrome(weegfx::Graphics &graphics) {
+  header(graphics, "Setup / About");
+  graphics.drawStr(0, 15, "Hemisphere Suite");
+  graphics.drawStr(0, 25, "v1.4");
+  graphics.drawStr(0, 35, "beigemaze.com/hs");
+  graphics.drawStr(0, 55, "[CALIBRATE]   [RESET]");
+}
+
+static void (*const kChromes[])(weegfx::Graphics &) = { enigma_chrome, midi_chrome, setup_chrome };
+static const char *const kChromeNames[] = { "Enigma", "CaptainMIDI", "Setup" };
+
+// Dynamic part of a screen, including an invert over the chrome
+static void screen_contents(weegfx::Graphics &graphics) {
+  for (coord_t line = 0; line < 4; ++line) {
+    graphics.print(line);
+    graphics.print(": Tk1");
+    graphics.setPrintPos(3, 24 + 10 * (line + 1));
+  }
+  graphics.invertRect(1, 24, 46, 9);
+  graphics.drawStr(56, 35, "Track 2");
+}
+
+TEST(WeegfxTest, Layer) {
+  weegfx::Graphics graphics;
+  graphics.Init();
+  weegfx::Layer layer;
+  const int owners[2] = { 0, 0 };
+  EXPECT_FALSE(layer.valid(nullptr, 0));
+
+  for (uint32_t key = 0; key < 3; ++key) {
+    Frame expected, frame;
+    graphics.Begin(expected.data, true);
+    kChromes[key](graphics);
+    graphics.setPrintPos(3, 24);
+    screen_contents(graphics);
+    graphics.End();
+
+    graphics.Begin(frame.data, true);
+    graphics.setPrintPos(3, 24);
+    EXPECT_FALSE(layer.valid(&owners[0], key));
+    graphics.BeginLayer(layer, &owners[0], key);
+    kChromes[key](graphics);
+    graphics.EndLayer();
+    EXPECT_TRUE(layer.valid(&owners[0], key));
+    // Same key from another user of the layer
+    EXPECT_FALSE(layer.valid(&owners[1], key));
+    graphics.drawLayer(layer);
+    screen_contents(graphics); // print pos is restored
+    graphics.End();
+
+    EXPECT_EQ(0, memcmp(expected.data, frame.data, kFrameSize)) << kChromeNames[key];
+  }
+
+  layer.Invalidate();
+  EXPECT_FALSE(layer.valid(&owners[0], 2));
+}
+
+// Typed print output should look the same as the string from snprintf. The
+// marker after the output checks the print position was advanced correctly.
+static void expect_prints(const char *expected, void (*print)(weegfx::Graphics &)) {
+  weegfx::Graphics graphics;
+  graphics.Init();
+  Frame expected_frame, frame;
+
+  graphics.Begin(expected_frame.data, true);
+  graphics.setPrintPos(2, 3);
+  graphics.print(expected);
+  graphics.print('|');
+  graphics.End();
+
+  graphics.Begin(frame.data, true);
+  graphics.setPrintPos(2, 3);
+  print(graphics);
+  graphics.print('|');
+  graphics.End();
+
+  EXPECT_EQ(0, memcmp(expected_frame.data, frame.data, kFrameSize)) << "'" << expected << "'";
+}
+
+TEST(WeegfxTest, PrintIntegers) {
+  static const int kValues[] = { 0, 1, -1, 9, 10, -10, 99, 12345, -12345, 2147483647, -2147483647 };
+  static int value;
+  static unsigned width;
+  char buf[32];
+  for (int v : kValues) {
+    value = v;
+    snprintf(buf, sizeof(buf), "%d", v);
+    expect_prints(buf, [](weegfx::Graphics &g) { g.print(value); });
+    snprintf(buf, sizeof(buf), v ? "%+d" : " 0", v);
+    expect_prints(buf, [](weegfx::Graphics &g) { g.pretty_print(value); });
+    for (width = 0; width < 8; ++width) {
+      snprintf(buf, sizeof(buf), "%*d", width, v);
+      expect_prints(buf, [](weegfx::Graphics &g) { g.print(value, width); });
+      snprintf(buf, sizeof(buf), "%*u", width, static_cast<uint32_t>(v));
+      expect_prints(buf, [](weegfx::Graphics &g) { g.print(static_cast<uint32_t>(value), width); });
+      snprintf(buf, sizeof(buf), "%0*X", width, static_cast<uint32_t>(v));
+      expect_prints(buf, [](weegfx::Graphics &g) { g.print_hex(value, width); });
+    }
+  }
+}
+
+TEST(WeegfxTest, PrintFixed) {
+  static int32_t value;
+  static unsigned decimals;
+  char buf[32];
+  for (int32_t v = -20000; v <= 20000; v += 37) {
+    value = v;
+    for (decimals = 0; decimals < 4; ++decimals) {
+      // Same truncation as HemisphereApplet::gfxPrintVoltage
+      int32_t scaled = v * kPow10[decimals] / 1536;
+      snprintf(buf, sizeof(buf), "%c%d", scaled < 0 ? '-' : '+', std::abs(scaled) / kPow10[decimals]);
+      if (decimals)
+        snprintf(buf + strlen(buf), sizeof(buf) - strlen(buf), ".%0*d", decimals, std::abs(scaled) % kPow10[decimals]);
+      expect_prints(buf, [](weegfx::Graphics &g) { g.print_fixed(value, 1536, decimals, true); });
+    }
+  }
+
+  expect_prints("  1.000", [](weegfx::Graphics &g) { g.print_fixed(1000, 1000, 3, false, 7); });
+  expect_prints("-12.345", [](weegfx::Graphics &g) { g.print_fixed(-12345, 1000, 3, false, 7); });
+  expect_prints("-0.5", [](weegfx::Graphics &g) { g.print_fixed(-1, 2, 1, false); });
+  expect_prints("0", [](weegfx::Graphics &g) { g.print_fixed(0, 1, 0, false); });
+  expect_prints("12345.678", [](weegfx::Graphics &g) { g.print_fixed(12345678, 1000, 3, false); });
+}
+
+TEST(WeegfxTest, PrintNote) {
+  static const char *const kNames[] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+  static int note;
+  char buf[32];
+  for (note = -24; note < 128; ++note) {
+    snprintf(buf, sizeof(buf), "%s%d", kNames[(note + 120) % 12], (note + 120) / 12 - 11);
+    expect_prints(buf, [](weegfx::Graphics &g) { g.print_note(note); });
+  }
+}
+
+// Timings for the word-wise drawing, pre-shifted icons, layers and typed
+// print. These only mean something with optimisation, so the benchmark isn't
+// part of the default run: make bench
+template <typename Function>
+static double ns_per_call(int calls, Function function) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < calls; ++i)
+    function(i);
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+}
+
+TEST(WeegfxTest, DISABLED_Benchmark) {
+  Frame frame;
+  weegfx::Graphics graphics;
+  graphics.Init();
+
+  std::vector<Primitive> primitives;
+  std::mt19937 rng(0xbe9c);
+  for (int i = 0; i < 1000; ++i)
+    primitives.push_back(random_primitive(rng));
+  static const char *const kNames[] = { "drawRect", "clearRect", "invertRect", "drawHLine", "drawBitmap8", "drawStr" };
+  for (int type = 0; type < Primitive::TYPES; ++type) {
+    double ns[2];
+    for (int words = 0; words < 2; ++words) {
+      ns[words] = ns_per_call(100, [&](int) {
+        graphics.Begin(frame.data, true);
+        for (const Primitive &p : primitives) {
+          if (p.type != type) continue;
+          if (words) draw(graphics, p); else draw_reference(frame.data, p);
+        }
+        graphics.End();
+      });
+    }
+    printf("[ weegfx   ] %-12s bytes %6.0f ns/frame, words %6.0f ns/frame (%.2fx)\n",
+           kNames[type], ns[0], ns[1], ns[0] / ns[1]);
+  }
+
+  // 8 rows of 20 glyphs; y = 0 is the page aligned path, y = 3 the general path
+  const char *text = "0123456789ABCDEFGHIJ";
+  double text_ns[3];
+  for (int path = 0; path < 3; ++path) {
+    graphics.Begin(frame.data, true);
+    text_ns[path] = ns_per_call(2000, [&](int) {
+      for (coord_t row = 0; row < 8; ++row) {
+        if (path == 2) {
+          reference::text(frame.data, 4, row * 8, text);
+        } else {
+          graphics.setPrintPos(4, row * 8 + (path ? 3 : 0));
+          graphics.print(text);
+        }
+      }
+    }) / (8 * 20);
+    graphics.End();
+  }
+  printf("[ weegfx   ] per glyph: aligned %5.1f ns, unaligned %5.1f ns, byte-wise aligned %5.1f ns\n",
+         text_ns[0], text_ns[1], text_ns[2]);
+
+  weegfx::PreshiftedBitmap8<8> icon;
+  icon.Init(kBitmap);
+  double icon_ns[3];
+  for (int test = 0; test < 3; ++test) {
+    graphics.Begin(frame.data, true);
+    icon_ns[test] = ns_per_call(1000000, [&](int i) {
+      // Mostly not page-aligned
+      const coord_t x = (i * 8) & 0x78;
+      const coord_t y = (i * 3) % 57;
+      if (test == 0)
+        graphics.drawBitmap8(x, y, icon);
+      else if (test == 1)
+        graphics.drawBitmap8(x, y, 8, kBitmap);
+      else
+        reference::bitmap8(frame.data, x, y, 8, kBitmap);
+    });
+    graphics.End();
+  }
+  printf("[ weegfx   ] per 8x8 blit: pre-shifted %5.1f ns, shifted %5.1f ns, byte-wise %5.1f ns\n",
+         icon_ns[0], icon_ns[1], icon_ns[2]);
+
+  // Cleared frame + chrome vs. cleared frame + layer, as in a GRAPHICS_BEGIN_FRAME
+  weegfx::Layer layer;
+  for (int key = 0; key < 3; ++key) {
+    graphics.BeginLayer(layer, nullptr, key);
+    kChromes[key](graphics);
+    graphics.EndLayer();
+    double ns[2];
+    for (int cached = 0; cached < 2; ++cached) {
+      ns[cached] = ns_per_call(20000, [&](int) {
+        graphics.Begin(frame.data, true);
+        if (cached)
+          graphics.drawLayer(layer);
+        else
+          kChromes[key](graphics);
+        graphics.End();
+      });
+    }
+    printf("[ weegfx   ] %-12s chrome %6.0f ns/frame, layer %6.0f ns/frame (%.2fx)\n",
+           kChromeNames[key], ns[0], ns[1], ns[0] / ns[1]);
+  }
+
+  const int kCalls = 20000;
+  double print_ns[2];
+  graphics.Begin(frame.data, true);
+  for (int typed = 0; typed < 2; ++typed) {
+    print_ns[typed] = ns_per_call(kCalls, [&](int i) {
+      graphics.setPrintPos(0, (i & 7) * 8);
+      if (typed) {
+        graphics.print(static_cast<uint32_t>(i % 1000), 3);
+        graphics.print(i - kCalls / 2, 6);
+        graphics.print_fixed(i - kCalls / 2, 1536, 2, true);
+      } else {
+        graphics.printf("%3u%6d%+d.%02d", i % 1000, i - kCalls / 2,
+                        (i - kCalls / 2) / 1536, std::abs((i - kCalls / 2) * 100 / 1536) % 100);
+      }
+    });
+  }
+  graphics.End();
+  printf("[ weegfx   ] printf %6.0f ns/call, typed %6.0f ns/call (%.2fx)\n",
+         print_ns[0], print_ns[1], print_ns[0] / print_ns[1]);
+}